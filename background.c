@@ -0,0 +1,160 @@
+/** @file background.c
+ *  @brief background source file.
+ *
+ *  This module implements the background solver, which solves the game position in solve mode as soon as a move
+ *  is made, while the user thinks about the next command. A newer position cancels the job of the previous one.
+ *  The worker never touches the game board or the solution cache: it works on a copy of the position,
+ *  and the main thread moves a finished solution into the cache when a command needs it.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "background.h"
+#include "bit_solver.h"
+#include "cache.h"
+#include "main_aux.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/* -- Global Variables  -- */
+extern __thread int blockRows;
+extern __thread int blockCols;
+
+backgroundSolver background;
+
+
+/* Worker loop: takes the latest posted position and solves it, until quit is set */
+void* background_worker(void* arg) {
+    bool solved;
+    int i;
+    (void) arg;
+    pthread_mutex_lock(&background.lock);
+    while (!background.quit) {
+        if (!background.pending) {
+            pthread_cond_wait(&background.changed, &background.lock);
+            continue;
+        }
+        background.pending = false;
+        background.busy = true;
+        background.stop = false;
+        background.resultHash = background.postedHash;
+        solved = bit_load_string(background.s, background.puzzle, background.rows, background.cols);
+        pthread_mutex_unlock(&background.lock);
+        background.s->stop = &background.stop; /* bit_load_string() resets the context */
+        solved = solved && bit_solve(background.s);
+        pthread_mutex_lock(&background.lock);
+        background.busy = false;
+        if (!background.stop) { /* not cancelled by a newer position */
+            background.done = true;
+            background.solvable = solved;
+            for (i = 0; solved && i < background.s->size; i++) {
+                background.solution[i] = background.s->grid[i];
+            }
+        }
+        pthread_cond_broadcast(&background.changed);
+    }
+    pthread_mutex_unlock(&background.lock);
+    return NULL;
+}
+
+/* Starts the worker thread, or cancels its job and joins it */
+void background_enable(bool enable) {
+    if (enable == background.enabled) {
+        return;
+    }
+    if (enable) {
+        background.s = malloc(sizeof(bitSolver));
+        if (background.s == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+        pthread_mutex_init(&background.lock, NULL);
+        pthread_cond_init(&background.changed, NULL);
+        background.quit = false;
+        background.pending = false;
+        background.busy = false;
+        background.done = false;
+        background.postedHash = 0;
+        background.rows = 0;
+        background.enabled = true;
+        pthread_create(&background.thread, NULL, background_worker, NULL);
+        return;
+    }
+    pthread_mutex_lock(&background.lock);
+    background.quit = true;
+    background.stop = true;
+    pthread_cond_broadcast(&background.changed);
+    pthread_mutex_unlock(&background.lock);
+    pthread_join(background.thread, NULL);
+    pthread_cond_destroy(&background.changed);
+    pthread_mutex_destroy(&background.lock);
+    free(background.s);
+    background.enabled = false;
+}
+
+/* Returns true while the worker thread runs */
+bool background_enabled() {
+    return background.enabled;
+}
+
+/* Copies the position for the worker and cancels the job of an older position */
+void background_post(cell** board, unsigned long hash) {
+    int i, j;
+    int N = blockRows * blockCols;
+    int values[MAX_BOARD_CELLS];
+    if (!background.enabled || N > MAX_BOARD_SIZE) {
+        return;
+    }
+    if (background.rows == blockRows && background.cols == blockCols && background.postedHash == hash) {
+        return; /* the board did not change */
+    }
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            values[i * N + j] = board[i][j].number;
+        }
+    }
+    pthread_mutex_lock(&background.lock);
+    bit_format_values(values, N * N, background.puzzle);
+    background.postedHash = hash;
+    background.rows = blockRows;
+    background.cols = blockCols;
+    background.pending = true;
+    background.stop = true;
+    pthread_cond_broadcast(&background.changed);
+    pthread_mutex_unlock(&background.lock);
+}
+
+/* Drops the posted position and stops the job being solved */
+void background_cancel() {
+    if (!background.enabled) {
+        return;
+    }
+    pthread_mutex_lock(&background.lock);
+    background.pending = false;
+    background.stop = true;
+    background.rows = 0; /* the next post is never taken for the same position */
+    pthread_mutex_unlock(&background.lock);
+}
+
+/* Waits while the worker has the posted position pending or in progress, then caches its solution */
+void background_collect() {
+    if (!background.enabled) {
+        return;
+    }
+    pthread_mutex_lock(&background.lock);
+    if (background.rows == blockRows && background.cols == blockCols) { /* not cancelled */
+        while (background.pending || background.busy) {
+            pthread_cond_wait(&background.changed, &background.lock);
+        }
+        if (background.done && background.solvable && background.resultHash == background.postedHash) {
+            cache_store(background.resultHash, background.solution);
+        }
+        background.done = false; /* the solution is in the cache now */
+    }
+    pthread_mutex_unlock(&background.lock);
+}
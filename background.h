@@ -0,0 +1,93 @@
+/** @file background.h
+ *  @brief background header file.
+ *
+ *  This header contains the prototypes for the background solver module.
+ *  contains the structure definition of the background solver state.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_BACKGROUND_H
+#define SUDOKU_BACKGROUND_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include "bit_solver.h"
+#include <pthread.h>
+
+
+/* -- Structs -- */
+
+/**
+ * @brief backgroundSolver structure representing a worker thread which solves the game position after every move,
+ * so the following hint, validate or completion check finds the solution in the solution cache.
+ * backgroundSolver contains thread, lock and changed fields, changed is signaled when a job is posted or finished.
+ * backgroundSolver contains enabled field, true while the worker thread runs, and quit field which ends it.
+ * backgroundSolver contains pending field, true when a posted position was not taken by the worker yet,
+ * and busy field, true while the worker is solving.
+ * backgroundSolver contains postedHash, rows, cols and puzzle fields describing the last posted position
+ * (puzzle holds its one-line representation).
+ * backgroundSolver contains done, solvable, resultHash and solution fields holding the result of the last finished job.
+ * backgroundSolver contains stop field, set to cancel the job being solved when a newer position is posted.
+ * backgroundSolver contains s field, the search context of the worker.
+ *
+ */
+typedef struct backgroundSolver {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    bool enabled;
+    bool quit;
+    bool pending;
+    bool busy;
+    unsigned long postedHash;
+    int rows;
+    int cols;
+    char puzzle[MAX_BOARD_CELLS + 1];
+    bool done;
+    bool solvable;
+    unsigned long resultHash;
+    int solution[MAX_BOARD_CELLS];
+    volatile bool stop;
+    bitSolver* s;
+} backgroundSolver;
+
+
+/** @brief Starts or stops the background solver thread.
+ *  @param enable true to start, false to stop.
+ *  @return void.
+ */
+void background_enable(bool enable);
+
+
+/** @brief Returns true if the background solver is running.
+ *  @return true if enabled, else false.
+ */
+bool background_enabled();
+
+
+/** @brief Posts the game position to the background solver, cancelling the job of an older position.
+ *  does nothing if the solver is disabled, the position was already posted or the board is too large.
+ *  @param board sudoku board of the global board dimensions, remains unchanged.
+ *  @param hash board hash.
+ *  @return void.
+ */
+void background_post(cell** board, unsigned long hash);
+
+
+/** @brief Cancels the background job, used when the game leaves solve mode.
+ *  @return void.
+ */
+void background_cancel();
+
+
+/** @brief Waits for the job of the last posted position, if it was not cancelled,
+ *  and stores its solution in the solution cache.
+ *  @return void.
+ */
+void background_collect();
+
+
+#endif /*SUDOKU_BACKGROUND_H*/
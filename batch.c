@@ -0,0 +1,710 @@
+/** @file batch.c
+ *  @brief batch source file.
+ *
+ *  This module implements the non-interactive batch mode, which runs a whole corpus of puzzles
+ *  (one puzzle per line) through the bit solver and reports throughput statistics,
+ *  and the batch generation mode, which writes freshly generated unique puzzles in the same format.
+ *  The corpus flows through a pipeline of a reader thread, a pool of solver workers and a writer,
+ *  in chunks of consecutive lines taken from a fixed pool. Generation uses the same pool, workers and writer without a reader.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Defines -- */
+#define _GNU_SOURCE
+
+/* -- Includes -- */
+#include "batch.h"
+#include "bit_solver.h"
+#include "generator.h"
+#include "grader.h"
+#include "histogram.h"
+#include "main_aux.h"
+#include "queue.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* -- Defines -- */
+#define LINE_SIZE (MAX_BOARD_CELLS + 3) /* symbols, "\r\n" and terminating null */
+#define OUTPUT_BUFFER_SIZE 65536
+
+
+/* Parses batch solve arguments, prints usage message if they are invalid */
+bool parse_batch_args(int argc, char* argv[], batchOptions* options) {
+    int i = 3;
+    options->corpusPath = NULL;
+    options->outputPath = NULL;
+    options->task = 'S';
+    options->blockRows = 0;
+    options->blockCols = 0;
+    options->threads = get_cpu_count();
+    options->count = 0;
+    options->clues = 0;
+    options->seed = 0;
+    options->symmetric = false;
+    options->solutions = false;
+    options->grade = false;
+    if (argc < 3) {
+        fprintf(stderr, BATCH_USAGE);
+        return false;
+    }
+    options->corpusPath = argv[2];
+    while (i < argc) {
+        if ((strcmp(argv[i], "--output") == 0 || strcmp(argv[i], "-o") == 0) && i + 1 < argc) {
+            options->outputPath = argv[i + 1];
+            i += 2;
+        } else if (strcmp(argv[i], "--count") == 0) {
+            options->task = 'C';
+            i++;
+        } else if (strcmp(argv[i], "--unique") == 0) {
+            options->task = 'U';
+            i++;
+        } else if (strcmp(argv[i], "--grade") == 0) {
+            options->task = 'D';
+            i++;
+        } else if (strcmp(argv[i], "--block") == 0 && i + 2 < argc) {
+            options->blockRows = atoi(argv[i + 1]);
+            options->blockCols = atoi(argv[i + 2]);
+            if (options->blockRows < 1 || options->blockCols < 1
+                || options->blockRows * options->blockCols > MAX_BOARD_SIZE) {
+                fprintf(stderr, "Error: block dimensions must multiply to 1-%d\n", MAX_BOARD_SIZE);
+                return false;
+            }
+            i += 3;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options->threads = atoi(argv[i + 1]);
+            if (options->threads < 1) {
+                fprintf(stderr, "Error: amount of threads must be positive\n");
+                return false;
+            }
+            i += 2;
+        } else {
+            fprintf(stderr, BATCH_USAGE);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Parses batch generation arguments, prints usage message if they are invalid */
+bool parse_generate_args(int argc, char* argv[], batchOptions* options) {
+    int i = 5;
+    int N;
+    if (argc < 5 || !is_integer(argv[2]) || !is_integer(argv[3]) || !is_integer(argv[4])) {
+        fprintf(stderr, GENERATE_USAGE);
+        return false;
+    }
+    options->corpusPath = NULL;
+    options->outputPath = NULL;
+    options->task = 'G';
+    options->threads = get_cpu_count();
+    options->count = atol(argv[2]);
+    N = atoi(argv[3]);
+    options->clues = atoi(argv[4]);
+    options->seed = (unsigned long) time(NULL);
+    options->symmetric = false;
+    options->solutions = false;
+    options->grade = false;
+    if (N < 1 || N > MAX_BOARD_SIZE) {
+        fprintf(stderr, "Error: board size must be 1-%d\n", MAX_BOARD_SIZE);
+        return false;
+    }
+    options->blockRows = infer_block_rows(N);
+    options->blockCols = N / options->blockRows;
+    if (options->count < 0 || options->clues < 0 || options->clues > N * N) {
+        fprintf(stderr, "Error: count must be non negative and clues 0-%d\n", N * N);
+        return false;
+    }
+    while (i < argc) {
+        if ((strcmp(argv[i], "--output") == 0 || strcmp(argv[i], "-o") == 0) && i + 1 < argc) {
+            options->outputPath = argv[i + 1];
+            i += 2;
+        } else if (strcmp(argv[i], "--solutions") == 0) {
+            options->solutions = true;
+            i++;
+        } else if (strcmp(argv[i], "--grade") == 0) {
+            options->grade = true;
+            i++;
+        } else if (strcmp(argv[i], "--symmetric") == 0) {
+            options->symmetric = true;
+            i++;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc && is_integer(argv[i + 1])) {
+            options->seed = strtoul(argv[i + 1], NULL, 10);
+            i += 2;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options->threads = atoi(argv[i + 1]);
+            if (options->threads < 1) {
+                fprintf(stderr, "Error: amount of threads must be positive\n");
+                return false;
+            }
+            i += 2;
+        } else {
+            fprintf(stderr, GENERATE_USAGE);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Parses transform generation arguments, prints usage message if they are invalid */
+bool parse_generate_from_args(int argc, char* argv[], batchOptions* options) {
+    int i = 4;
+    if (argc < 4 || !is_integer(argv[3]) || atol(argv[3]) < 0) {
+        fprintf(stderr, GENERATE_FROM_USAGE);
+        return false;
+    }
+    options->corpusPath = argv[2];
+    options->outputPath = NULL;
+    options->task = 'T';
+    options->blockRows = 0;
+    options->blockCols = 0;
+    options->threads = 1;
+    options->count = atol(argv[3]);
+    options->clues = 0;
+    options->seed = (unsigned long) time(NULL);
+    options->symmetric = false;
+    options->solutions = false;
+    options->grade = false;
+    while (i < argc) {
+        if ((strcmp(argv[i], "--output") == 0 || strcmp(argv[i], "-o") == 0) && i + 1 < argc) {
+            options->outputPath = argv[i + 1];
+            i += 2;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc && is_integer(argv[i + 1])) {
+            options->seed = strtoul(argv[i + 1], NULL, 10);
+            i += 2;
+        } else if (strcmp(argv[i], "--block") == 0 && i + 2 < argc) {
+            options->blockRows = atoi(argv[i + 1]);
+            options->blockCols = atoi(argv[i + 2]);
+            if (options->blockRows < 1 || options->blockCols < 1
+                || options->blockRows * options->blockCols > MAX_BOARD_SIZE) {
+                fprintf(stderr, "Error: block dimensions must multiply to 1-%d\n", MAX_BOARD_SIZE);
+                return false;
+            }
+            i += 3;
+        } else {
+            fprintf(stderr, GENERATE_FROM_USAGE);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Reads the next corpus line into line.
+ * returns 1 if a line was read, 0 on end of file and -1 if the line was too long (it is skipped) */
+int read_corpus_line(FILE* fp, char* line) {
+    if (fgets(line, LINE_SIZE, fp) == NULL) {
+        return 0;
+    }
+    if (strchr(line, '\n') == NULL && !feof(fp)) { /* cleaning rest of the line */
+        while (fgets(line, LINE_SIZE, fp) != NULL && strchr(line, '\n') == NULL);
+        return -1;
+    }
+    return 1;
+}
+
+/* Returns true if line contains no puzzle (blank line or comment) */
+bool skip_corpus_line(char* line) {
+    while (*line == ' ' || *line == '\t') {
+        line++;
+    }
+    return (*line == '\0' || *line == '\n' || *line == '\r' || *line == '#');
+}
+
+/* Processes a single corpus line according to the batch task, result is written without a newline */
+int process_puzzle(bitSolver* s, char* line, batchOptions* options, char* result) {
+    long solutions;
+    gradeResult grade;
+    if (!bit_load_string(s, line, options->blockRows, options->blockCols)) {
+        strcpy(result, "invalid");
+        return BATCH_INVALID;
+    }
+    if (options->task == 'C') {
+        solutions = bit_count(s, 0);
+        sprintf(result, "%ld", solutions);
+    } else if (options->task == 'U') {
+        solutions = bit_count(s, 2);
+        strcpy(result, (solutions == 0) ? "unsolvable" : ((solutions == 1) ? "unique" : "multiple"));
+    } else if (options->task == 'D') {
+        grade_puzzle(s, &grade);
+        sprintf(result, "%s %ld", grade_level(&grade), grade.score);
+        solutions = grade.contradiction ? 0 : 1;
+    } else {
+        solutions = bit_solve(s) ? 1 : 0;
+        if (solutions == 1) {
+            bit_format_string(s, result);
+        } else {
+            strcpy(result, "unsolvable");
+        }
+    }
+    return (solutions == 0) ? BATCH_UNSOLVABLE : BATCH_SOLVED;
+}
+
+/* Updates the batch statistics with the outcome of a single puzzle */
+void record_puzzle(batchStats* stats, int outcome, double elapsed) {
+    stats->puzzles++;
+    if (outcome == BATCH_UNSOLVABLE) {
+        stats->unsolvable++;
+    } else if (outcome == BATCH_INVALID) {
+        stats->invalid++;
+    }
+    histogram_record(&stats->latency, elapsed);
+}
+
+/* Prints the throughput and latency percentiles of a batch run to stderr */
+void print_throughput(batchStats* stats, double seconds) {
+    fprintf(stderr, "Throughput: %.1f puzzles/sec\n", (seconds > 0) ? stats->puzzles / seconds : 0.0);
+    fprintf(stderr, "Latency: p50 %.1f us, p99 %.1f us, max %.1f us\n",
+            histogram_percentile(&stats->latency, 50) / 1000, histogram_percentile(&stats->latency, 99) / 1000,
+            stats->latency.max / 1000);
+}
+
+/* Prints the batch solve statistics to stderr */
+void print_batch_stats(batchStats* stats, double elapsedNs) {
+    double seconds = elapsedNs / 1e9;
+    fprintf(stderr, "Processed %ld puzzles (%ld unsolvable, %ld invalid) in %.3f s\n",
+            stats->puzzles, stats->unsolvable, stats->invalid, seconds);
+    print_throughput(stats, seconds);
+}
+
+/* Prints the batch generation statistics to stderr */
+void print_generate_stats(batchStats* stats, batchOptions* options, double elapsedNs) {
+    double seconds = elapsedNs / 1e9;
+    fprintf(stderr, "Generated %ld puzzles (%ld minimal above %d clues, %ld failed) in %.3f s, seed %lu\n",
+            stats->puzzles, stats->unsolvable, options->clues, stats->invalid, seconds, options->seed);
+    print_throughput(stats, seconds);
+}
+
+/* Reader stage: fills free chunks with corpus lines and passes them to the workers in corpus order */
+void* batch_reader(void* arg) {
+    batchPipeline* p = (batchPipeline*) arg;
+    batchChunk* chunk;
+    int status, used;
+    long sequence = 0;
+    bool endOfFile = false;
+    while (!endOfFile) {
+        chunk = (batchChunk*) queue_pop(&p->freeChunks);
+        chunk->count = 0;
+        used = 0;
+        while (chunk->count < CHUNK_MAX_PUZZLES && CHUNK_TEXT_SIZE - used >= LINE_SIZE) {
+            status = read_corpus_line(p->in, chunk->text + used);
+            if (status == 0) {
+                endOfFile = true;
+                break;
+            }
+            if (status > 0 && skip_corpus_line(chunk->text + used)) {
+                continue;
+            }
+            if (status < 0) { /* too long to be a board, an illegal symbol makes the worker report it as invalid */
+                strcpy(chunk->text + used, "!");
+            }
+            chunk->offsets[chunk->count] = used;
+            chunk->count++;
+            used += strlen(chunk->text + used) + 1;
+        }
+        if (chunk->count > 0) {
+            chunk->sequence = sequence;
+            sequence++;
+            queue_push(&p->filledChunks, chunk);
+        } else {
+            queue_push(&p->freeChunks, chunk);
+        }
+    }
+    queue_close(&p->filledChunks);
+    return NULL;
+}
+
+/* Marks the calling worker as finished, the last worker closes the solved chunks queue to stop the writer */
+void finish_worker(batchPipeline* p) {
+    pthread_mutex_lock(&p->workersLock);
+    p->activeWorkers--;
+    if (p->activeWorkers == 0) {
+        queue_close(&p->solvedChunks);
+    }
+    pthread_mutex_unlock(&p->workersLock);
+}
+
+/* Worker stage: solves every puzzle of the filled chunks into the chunk results */
+void* batch_worker(void* arg) {
+    batchWorker* worker = (batchWorker*) arg;
+    batchPipeline* p = worker->pipeline;
+    batchChunk* chunk;
+    bitSolver* s;
+    int k, outcome;
+    double puzzleStart;
+    s = malloc(sizeof(bitSolver));
+    if (s == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    while ((chunk = (batchChunk*) queue_pop(&p->filledChunks)) != NULL) {
+        chunk->resultsLength = 0;
+        for (k = 0; k < chunk->count; k++) {
+            puzzleStart = get_time_ns();
+            outcome = process_puzzle(s, chunk->text + chunk->offsets[k], p->options,
+                                     chunk->results + chunk->resultsLength);
+            record_puzzle(&worker->stats, outcome, get_time_ns() - puzzleStart);
+            chunk->resultsLength += strlen(chunk->results + chunk->resultsLength);
+            chunk->results[chunk->resultsLength] = '\n';
+            chunk->resultsLength++;
+        }
+        queue_push(&p->solvedChunks, chunk);
+    }
+    free(s);
+    finish_worker(p);
+    return NULL;
+}
+
+/* Writer stage: writes solved chunks in corpus order, holding early chunks in a reorder buffer.
+ * at most poolSize chunks are in flight, so sequence modulo poolSize never collides */
+void write_ordered_results(batchPipeline* p) {
+    batchChunk** reorder;
+    batchChunk* chunk;
+    long next = 0;
+    reorder = calloc(p->poolSize, sizeof(batchChunk*));
+    if (reorder == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    while ((chunk = (batchChunk*) queue_pop(&p->solvedChunks)) != NULL) {
+        reorder[chunk->sequence % p->poolSize] = chunk;
+        while ((chunk = reorder[next % p->poolSize]) != NULL && chunk->sequence == next) {
+            reorder[next % p->poolSize] = NULL;
+            fwrite(chunk->results, 1, chunk->resultsLength, p->out);
+            queue_push(&p->freeChunks, chunk);
+            next++;
+        }
+    }
+    free(reorder);
+}
+
+/* Initializes the pipeline queues and synchronization, and fills the free chunks queue with a new pool of chunks.
+ * returns the pool */
+batchChunk* pipeline_initialize(batchPipeline* p, batchOptions* options) {
+    batchChunk* chunks;
+    int i;
+    p->options = options;
+    p->poolSize = 2 * options->threads + 2; /* every worker busy with one chunk and holding one more, plus reader and writer */
+    p->activeWorkers = options->threads;
+    p->nextSequence = 0;
+    chunks = malloc(p->poolSize * sizeof(batchChunk));
+    if (chunks == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    queue_initialize(&p->freeChunks, p->poolSize);
+    queue_initialize(&p->filledChunks, p->poolSize);
+    queue_initialize(&p->solvedChunks, p->poolSize);
+    pthread_mutex_init(&p->workersLock, NULL);
+    for (i = 0; i < p->poolSize; i++) {
+        queue_push(&p->freeChunks, &chunks[i]);
+    }
+    return chunks;
+}
+
+/* Runs options->threads workers, writes their chunks in order on the calling thread
+ * and merges the worker statistics into stats */
+void pipeline_run(batchPipeline* p, void* (*work)(void*), batchStats* stats) {
+    batchWorker* workers;
+    int i;
+    workers = calloc(p->options->threads, sizeof(batchWorker));
+    if (workers == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    for (i = 0; i < p->options->threads; i++) {
+        workers[i].pipeline = p;
+        histogram_reset(&workers[i].stats.latency);
+        pthread_create(&workers[i].thread, NULL, work, &workers[i]);
+    }
+    write_ordered_results(p);
+    fflush(p->out);
+    histogram_reset(&stats->latency);
+    for (i = 0; i < p->options->threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+        stats->puzzles += workers[i].stats.puzzles;
+        stats->unsolvable += workers[i].stats.unsolvable;
+        stats->invalid += workers[i].stats.invalid;
+        histogram_merge(&stats->latency, &workers[i].stats.latency);
+    }
+    free(workers);
+}
+
+/* Destroys the pipeline queues and synchronization and frees the pool of chunks */
+void pipeline_destroy(batchPipeline* p, batchChunk* chunks) {
+    queue_destroy(&p->freeChunks);
+    queue_destroy(&p->filledChunks);
+    queue_destroy(&p->solvedChunks);
+    pthread_mutex_destroy(&p->workersLock);
+    free(chunks);
+}
+
+/* Solves every corpus puzzle in a reader, workers and writer pipeline, writing one result line per puzzle in input order */
+int batch_solve(batchOptions* options) {
+    batchPipeline p;
+    batchChunk* chunks;
+    batchStats* stats;
+    pthread_t reader;
+    int status;
+    double start;
+    p.out = stdout;
+    if ((p.in = fopen(options->corpusPath, "r")) == NULL) {
+        fprintf(stderr, "Error: File doesn't exist or cannot be opened\n");
+        return 1;
+    }
+    if (options->outputPath != NULL && (p.out = fopen(options->outputPath, "w")) == NULL) {
+        fprintf(stderr, "Error: File cannot be created or modified\n");
+        fclose(p.in);
+        return 1;
+    }
+    stats = calloc(1, sizeof(batchStats));
+    if (stats == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    chunks = pipeline_initialize(&p, options);
+    setvbuf(p.out, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+    start = get_time_ns();
+    pthread_create(&reader, NULL, batch_reader, &p);
+    pipeline_run(&p, batch_worker, stats);
+    pthread_join(reader, NULL);
+    print_batch_stats(stats, get_time_ns() - start);
+    status = ferror(p.in) || ferror(p.out);
+    if (p.out != stdout) {
+        fclose(p.out);
+    }
+    fclose(p.in);
+    pipeline_destroy(&p, chunks);
+    free(stats);
+    return status;
+}
+
+/* Generation worker: claims the next chunk sequence and generates its puzzles, until all puzzles were claimed */
+void* generate_worker(void* arg) {
+    batchWorker* worker = (batchWorker*) arg;
+    batchPipeline* p = worker->pipeline;
+    batchOptions* options = p->options;
+    batchChunk* chunk;
+    bitSolver* s;
+    gradeResult grade;
+    int solution[MAX_BOARD_CELLS];
+    int k, clues;
+    long first;
+    double puzzleStart;
+    char* out;
+    s = malloc(sizeof(bitSolver));
+    if (s == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    s->stop = NULL;
+    while ((chunk = (batchChunk*) queue_pop(&p->freeChunks)) != NULL) {
+        pthread_mutex_lock(&p->workersLock);
+        chunk->sequence = p->nextSequence;
+        p->nextSequence++;
+        pthread_mutex_unlock(&p->workersLock);
+        first = chunk->sequence * p->chunkPuzzles;
+        if (first >= options->count) { /* nothing left to claim */
+            queue_push(&p->freeChunks, chunk);
+            break;
+        }
+        chunk->count = (options->count - first < p->chunkPuzzles) ? (int) (options->count - first) : p->chunkPuzzles;
+        chunk->resultsLength = 0;
+        for (k = 0; k < chunk->count; k++) {
+            puzzleStart = get_time_ns();
+            prng_seed(&s->rng, options->seed + (unsigned long) (first + k) * 0x9E3779B9UL); /* puzzle k's own sequence */
+            clues = generate_unique(s, options->blockRows, options->blockCols, options->clues, options->symmetric,
+                                    options->solutions ? solution : NULL);
+            out = chunk->results + chunk->resultsLength;
+            if (clues < 0) {
+                strcpy(out, "failed");
+                worker->stats.invalid++;
+            } else {
+                bit_format_string(s, out);
+                if (options->solutions) {
+                    out[s->size] = ' ';
+                    bit_format_values(solution, s->size, out + s->size + 1);
+                }
+                if (options->grade) {
+                    grade_puzzle(s, &grade);
+                    strcat(out, " ");
+                    strcat(out, grade_level(&grade));
+                }
+                if (options->clues > 0 && clues > options->clues) { /* stopped at a minimal puzzle */
+                    worker->stats.unsolvable++;
+                }
+            }
+            worker->stats.puzzles++;
+            histogram_record(&worker->stats.latency, get_time_ns() - puzzleStart);
+            chunk->resultsLength += strlen(out);
+            chunk->results[chunk->resultsLength] = '\n';
+            chunk->resultsLength++;
+        }
+        queue_push(&p->solvedChunks, chunk);
+    }
+    free(s);
+    finish_worker(p);
+    return NULL;
+}
+
+/* Generates the batch puzzles in a workers and writer pipeline, writing one puzzle per line in puzzle order */
+int generate_batch(batchOptions* options) {
+    batchPipeline p;
+    batchChunk* chunks;
+    batchStats* stats;
+    int status, lineLength;
+    double start;
+    p.in = NULL;
+    p.out = stdout;
+    if (options->outputPath != NULL && (p.out = fopen(options->outputPath, "w")) == NULL) {
+        fprintf(stderr, "Error: File cannot be created or modified\n");
+        return 1;
+    }
+    stats = calloc(1, sizeof(batchStats));
+    if (stats == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    chunks = pipeline_initialize(&p, options);
+    lineLength = options->blockRows * options->blockCols * options->blockRows * options->blockCols + 1;
+    if (options->solutions) {
+        lineLength *= 2;
+    }
+    if (options->grade) {
+        lineLength += 11; /* a space and the longest level name */
+    }
+    p.chunkPuzzles = (int) (sizeof(chunks->results) / (lineLength + 1)); /* "failed" is shorter than any line */
+    if (p.chunkPuzzles > CHUNK_MAX_PUZZLES) {
+        p.chunkPuzzles = CHUNK_MAX_PUZZLES;
+    }
+    setvbuf(p.out, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+    start = get_time_ns();
+    pipeline_run(&p, generate_worker, stats);
+    print_generate_stats(stats, options, get_time_ns() - start);
+    status = ferror(p.out);
+    if (p.out != stdout) {
+        fclose(p.out);
+    }
+    pipeline_destroy(&p, chunks);
+    free(stats);
+    return status;
+}
+
+/* Reads every seed puzzle of the corpus, returns the array of seed lines and updates count.
+ * returns NULL if the corpus contains an invalid puzzle or no puzzle at all */
+char** read_seed_puzzles(FILE* fp, batchOptions* options, bitSolver* s, long* count) {
+    char line[LINE_SIZE];
+    char** seeds = NULL;
+    char** newSeeds;
+    long capacity = 0, lineNumber = 0;
+    int status;
+    *count = 0;
+    while ((status = read_corpus_line(fp, line)) != 0) {
+        lineNumber++;
+        if (status > 0 && skip_corpus_line(line)) {
+            continue;
+        }
+        if (status < 0 || !bit_load_string(s, line, options->blockRows, options->blockCols)) {
+            fprintf(stderr, "Error: invalid seed puzzle in line %ld\n", lineNumber);
+            break;
+        }
+        if (*count == capacity) {
+            capacity = (capacity == 0) ? 64 : 2 * capacity;
+            newSeeds = realloc(seeds, capacity * sizeof(char*));
+            if (newSeeds == NULL) {
+                memory_error("Memory allocation failed\n");
+                exit(0);
+            }
+            seeds = newSeeds;
+        }
+        seeds[*count] = malloc(strlen(line) + 1);
+        if (seeds[*count] == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+        strcpy(seeds[*count], line);
+        (*count)++;
+    }
+    if (status != 0 || *count == 0) {
+        if (status == 0) {
+            fprintf(stderr, "Error: no seed puzzles found\n");
+        }
+        while (*count > 0) {
+            (*count)--;
+            free(seeds[*count]);
+        }
+        free(seeds);
+        return NULL;
+    }
+    return seeds;
+}
+
+/* Writes the requested amount of transformed seed puzzles. every puzzle costs O(N^2), so a single thread keeps up with the output */
+int generate_from_batch(batchOptions* options) {
+    FILE* in;
+    FILE* out = stdout;
+    char** seeds;
+    char line[LINE_SIZE];
+    bitSolver* s;
+    batchStats* stats;
+    prng r;
+    long seedCount, k;
+    int status;
+    double start, puzzleStart;
+    if ((in = fopen(options->corpusPath, "r")) == NULL) {
+        fprintf(stderr, "Error: File doesn't exist or cannot be opened\n");
+        return 1;
+    }
+    s = malloc(sizeof(bitSolver));
+    stats = calloc(1, sizeof(batchStats));
+    if (s == NULL || stats == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    seeds = read_seed_puzzles(in, options, s, &seedCount);
+    fclose(in);
+    if (seeds == NULL || (options->outputPath != NULL && (out = fopen(options->outputPath, "w")) == NULL)) {
+        if (seeds != NULL) {
+            fprintf(stderr, "Error: File cannot be created or modified\n");
+            for (k = 0; k < seedCount; k++) {
+                free(seeds[k]);
+            }
+            free(seeds);
+        }
+        free(s);
+        free(stats);
+        return 1;
+    }
+    setvbuf(out, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+    histogram_reset(&stats->latency);
+    prng_seed(&r, options->seed);
+    start = get_time_ns();
+    for (k = 0; k < options->count; k++) {
+        puzzleStart = get_time_ns();
+        bit_load_string(s, seeds[prng_below(&r, seedCount)], options->blockRows, options->blockCols);
+        transform_grid(&r, s->grid, s->blockRows, s->blockCols);
+        bit_format_string(s, line);
+        fputs(line, out);
+        fputc('\n', out);
+        record_puzzle(stats, BATCH_SOLVED, get_time_ns() - puzzleStart);
+    }
+    fflush(out);
+    fprintf(stderr, "Generated %ld puzzles from %ld seed puzzles in %.3f s, seed %lu\n",
+            stats->puzzles, seedCount, (get_time_ns() - start) / 1e9, options->seed);
+    print_throughput(stats, (get_time_ns() - start) / 1e9);
+    status = ferror(out);
+    if (out != stdout) {
+        fclose(out);
+    }
+    for (k = 0; k < seedCount; k++) {
+        free(seeds[k]);
+    }
+    free(seeds);
+    free(s);
+    free(stats);
+    return status;
+}
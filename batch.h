@@ -0,0 +1,213 @@
+/** @file batch.h
+ *  @brief batch header file.
+ *
+ *  This header contains the prototypes for the batch module.
+ *  contains the structure definition of the batch mode options.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_BATCH_H
+#define SUDOKU_BATCH_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include "bit_solver.h"
+#include "histogram.h"
+#include "queue.h"
+#include <pthread.h>
+#include <stdio.h>
+
+
+/* -- Defines -- */
+#define BATCH_USAGE "Usage: sudoku-console --batch-solve <corpus> [--output <file>] [--count | --unique | --grade] [--block <rows> <cols>] [--threads <n>]\n"
+
+#define GENERATE_USAGE "Usage: sudoku-console --generate-batch <count> <size> <clues> [--output <file>] [--solutions] [--grade] [--symmetric] [--seed <n>] [--threads <n>]\n"
+
+#define GENERATE_FROM_USAGE "Usage: sudoku-console --generate-from <seeds> <count> [--output <file>] [--seed <n>] [--block <rows> <cols>]\n"
+
+#define BATCH_SOLVED 0
+#define BATCH_UNSOLVABLE 1
+#define BATCH_INVALID 2
+
+#define CHUNK_TEXT_SIZE 65536 /* corpus bytes read into a single chunk */
+#define CHUNK_MAX_PUZZLES 1024
+#define RESULT_SLACK 24 /* room for a result longer than its input line ("invalid", a count) */
+
+
+/* -- Structs -- */
+
+/**
+ * @brief batchOptions structure representing the options of a batch run.
+ * batchOptions contains corpusPath field containing the corpus file path, one puzzle per line.
+ * batchOptions contains outputPath field containing the results file path, NULL for stdout.
+ * batchOptions contains task field: 'S' to solve, 'C' to count solutions, 'U' to check uniqueness or 'D' to grade.
+ * batchOptions contains blockRows and blockCols fields, 0 to infer the block dimensions from every line.
+ * batchOptions contains threads field containing the amount of solver worker threads.
+ * batchOptions contains count, clues, seed, symmetric and solutions fields used by batch generation ('G' task):
+ * the amount of puzzles, the clues to dig down to, the master seed, the removal order and whether to write solutions.
+ * batchOptions contains grade field, when true batch generation appends the difficulty level of every puzzle.
+ * transform generation ('T' task) uses corpusPath for the seed puzzles and the count and seed fields.
+ *
+ */
+typedef struct batchOptions {
+    char* corpusPath;
+    char* outputPath;
+    char task;
+    int blockRows;
+    int blockCols;
+    int threads;
+    long count;
+    int clues;
+    unsigned long seed;
+    bool symmetric;
+    bool solutions;
+    bool grade;
+} batchOptions;
+
+
+/**
+ * @brief batchStats structure representing the statistics of a batch run.
+ * batchStats contains puzzles, unsolvable and invalid fields counting the lines processed by outcome,
+ * in batch generation invalid counts failed puzzles and unsolvable counts minimal puzzles above the target clues.
+ * batchStats contains latency field containing the per-puzzle processing time in nanoseconds.
+ *
+ */
+typedef struct batchStats {
+    long puzzles;
+    long unsolvable;
+    long invalid;
+    histogram latency;
+} batchStats;
+
+
+/**
+ * @brief batchChunk structure representing a block of consecutive corpus lines passed between the pipeline stages.
+ * batchChunk contains sequence field containing the chunk position in the corpus, used to restore input order.
+ * batchChunk contains count field containing the amount of puzzles and offsets field their positions in text.
+ * batchChunk contains text field containing the null terminated corpus lines.
+ * batchChunk contains results field containing the newline terminated result lines and resultsLength their length.
+ *
+ */
+typedef struct batchChunk {
+    long sequence;
+    int count;
+    int offsets[CHUNK_MAX_PUZZLES];
+    char text[CHUNK_TEXT_SIZE];
+    int resultsLength;
+    char results[CHUNK_TEXT_SIZE + CHUNK_MAX_PUZZLES * RESULT_SLACK];
+} batchChunk;
+
+
+/**
+ * @brief batchPipeline structure representing the state shared by the batch pipeline stages.
+ * the reader thread fills free chunks, solver workers solve filled chunks and the writer restores input order.
+ * the chunks pool is fixed, so memory stays constant and a slow stage blocks the stages feeding it.
+ * batchPipeline contains options, in and out fields containing the batch options and the corpus and results files.
+ * batchPipeline contains freeChunks, filledChunks and solvedChunks fields, the bounded queues between the stages.
+ * batchPipeline contains poolSize field containing the amount of chunks in the pool.
+ * batchPipeline contains activeWorkers field, the last worker to finish closes solvedChunks.
+ * batchPipeline contains nextSequence and chunkPuzzles fields used by batch generation, which has no reader:
+ * workers claim the next chunk sequence under workersLock and generate its chunkPuzzles puzzles.
+ *
+ */
+typedef struct batchPipeline {
+    batchOptions* options;
+    FILE* in;
+    FILE* out;
+    queue freeChunks;
+    queue filledChunks;
+    queue solvedChunks;
+    int poolSize;
+    int activeWorkers;
+    pthread_mutex_t workersLock;
+    long nextSequence;
+    int chunkPuzzles;
+} batchPipeline;
+
+
+/**
+ * @brief batchWorker structure representing a solver worker thread of the batch pipeline.
+ * batchWorker contains pipeline field pointing to the shared pipeline state.
+ * batchWorker contains thread field containing the thread id and stats field the worker's own statistics,
+ * which are merged after the run so workers never contend on them.
+ *
+ */
+typedef struct batchWorker {
+    batchPipeline* pipeline;
+    pthread_t thread;
+    batchStats stats;
+} batchWorker;
+
+
+/** @brief Parses the command line arguments of batch solve mode.
+ *  prints the usage message when arguments are invalid.
+ *  @param argc amount of arguments.
+ *  @param argv arguments, argv[1] is "--batch-solve".
+ *  @param options to be updated.
+ *  @return true if arguments are valid, else false.
+ */
+bool parse_batch_args(int argc, char* argv[], batchOptions* options);
+
+
+/** @brief Processes a single corpus line according to the batch task.
+ *  @param s search context to use.
+ *  @param line puzzle in one-line representation.
+ *  @param options batch options.
+ *  @param result buffer of at least the line length + RESULT_SLACK chars to be updated with the result line (without newline).
+ *  @return BATCH_SOLVED, BATCH_UNSOLVABLE or BATCH_INVALID.
+ */
+int process_puzzle(bitSolver* s, char* line, batchOptions* options, char* result);
+
+
+/** @brief Runs every puzzle of the corpus through the bit solver, writing one result line per puzzle in input order.
+ *  the corpus is read by a reader thread, solved by options->threads workers and written by the calling thread.
+ *  prints the throughput and latency percentiles to stderr when done.
+ *  @param options batch options.
+ *  @return process exit status, 0 on success.
+ */
+int batch_solve(batchOptions* options);
+
+
+/** @brief Parses the command line arguments of batch generation mode.
+ *  prints the usage message when arguments are invalid.
+ *  @param argc amount of arguments.
+ *  @param argv arguments, argv[1] is "--generate-batch".
+ *  @param options to be updated.
+ *  @return true if arguments are valid, else false.
+ */
+bool parse_generate_args(int argc, char* argv[], batchOptions* options);
+
+
+/** @brief Generates options->count unique puzzles on options->threads worker threads, writing one puzzle per line
+ *  (followed by a space and its solution if requested) in puzzle order.
+ *  puzzle k is generated from a generator seeded by the master seed and k, so the output depends only on the options
+ *  and not on the amount of threads. prints the seed, throughput and latency percentiles to stderr when done.
+ *  @param options batch options.
+ *  @return process exit status, 0 on success.
+ */
+int generate_batch(batchOptions* options);
+
+
+/** @brief Parses the command line arguments of transform generation mode.
+ *  prints the usage message when arguments are invalid.
+ *  @param argc amount of arguments.
+ *  @param argv arguments, argv[1] is "--generate-from".
+ *  @param options to be updated.
+ *  @return true if arguments are valid, else false.
+ */
+bool parse_generate_from_args(int argc, char* argv[], batchOptions* options);
+
+
+/** @brief Writes options->count puzzles, one per line, each made by a random transform of a random seed puzzle
+ *  (see transform_grid). the seed puzzles are read from options->corpusPath, one puzzle per line.
+ *  the output depends only on the seed puzzles and options->seed. prints the throughput to stderr when done.
+ *  @param options batch options.
+ *  @return process exit status, 0 on success.
+ */
+int generate_from_batch(batchOptions* options);
+
+
+#endif /*SUDOKU_BATCH_H*/
@@ -0,0 +1,648 @@
+/** @file bit_solver.c
+ *  @brief bit solver source file.
+ *
+ *  This module implements a fast sudoku search over bitmask candidates.
+ *  Every unit keeps a bitmask of the values it contains, so the candidates of a cell are computed with three ORs.
+ *  The search is an explicit depth first search which branches on a forced cell (a single candidate,
+ *  or a unit value with a single possible cell) when there is one, else on the cell with the fewest candidates.
+ *  The search state is kept in the context (not on the call stack), so a search can be stopped and resumed.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "bit_solver.h"
+#include "count_table.h"
+#include "stats.h"
+#include "main_aux.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+
+/* -- Defines -- */
+#define SEARCH_IDLE 0
+#define SEARCH_DESCEND 1
+#define SEARCH_ADVANCE 2
+
+
+/* Returns the amount of bits set in given mask */
+int count_bits(unsigned long mask) {
+#ifdef __GNUC__
+    return __builtin_popcountl(mask);
+#else
+    int counter = 0;
+    while (mask != 0) {
+        mask &= mask - 1;
+        counter++;
+    }
+    return counter;
+#endif
+}
+
+/* Returns the index of the lowest bit set in given (non zero) mask */
+int lowest_bit_index(unsigned long mask) {
+#ifdef __GNUC__
+    return __builtin_ctzl(mask);
+#else
+    int index = 0;
+    while ((mask & 1UL) == 0) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+/* Returns a uniformly chosen bit of the given (non zero) mask */
+unsigned long random_bit(prng* r, unsigned long mask) {
+    int k = prng_below(r, count_bits(mask));
+    while (k > 0) {
+        mask &= mask - 1; /* dropping lowest bit */
+        k--;
+    }
+    return mask & (~mask + 1);
+}
+
+/* Initializes an empty search context, precomputing the units of every cell */
+bool bit_init(bitSolver* s, int rows, int cols) {
+    int idx, row, col;
+    if (rows < 1 || cols < 1 || rows * cols > MAX_BOARD_SIZE) {
+        return false;
+    }
+    s->blockRows = rows;
+    s->blockCols = cols;
+    s->N = rows * cols;
+    s->size = s->N * s->N;
+    s->fullMask = ((1UL << (s->N - 1)) << 1) - 1; /* N low bits, also when N is the width of a long */
+    for (idx = 0; idx < s->size; idx++) {
+        row = idx / s->N;
+        col = idx % s->N;
+        s->grid[idx] = UNASSIGNED;
+        s->rowOf[idx] = (unsigned char) row;
+        s->colOf[idx] = (unsigned char) col;
+        s->boxOf[idx] = (unsigned char) ((row / rows) * rows + (col / cols));
+    }
+    memset(s->rowUsed, 0, sizeof(s->rowUsed));
+    memset(s->colUsed, 0, sizeof(s->colUsed));
+    memset(s->boxUsed, 0, sizeof(s->boxUsed));
+    s->emptyCount = 0;
+    s->depth = 0;
+    s->state = SEARCH_IDLE;
+    s->prefixCount = 0;
+    s->freeDigits = 0;
+    s->table = NULL;
+    s->found = 1;
+    s->nodes = 0;
+    s->nodeLimit = 0;
+    s->stop = NULL;
+    s->randomOrder = false;
+    return true;
+}
+
+/* Places value in cell and marks it as used in the cell's units */
+void bit_place(bitSolver* s, int idx, int val) {
+    unsigned long bit = 1UL << (val - 1);
+    s->grid[idx] = val;
+    s->rowUsed[s->rowOf[idx]] |= bit;
+    s->colUsed[s->colOf[idx]] |= bit;
+    s->boxUsed[s->boxOf[idx]] |= bit;
+}
+
+/* Removes cell value and marks it as unused in the cell's units */
+void bit_remove(bitSolver* s, int idx) {
+    unsigned long bit = ~(1UL << (s->grid[idx] - 1));
+    s->grid[idx] = UNASSIGNED;
+    s->rowUsed[s->rowOf[idx]] &= bit;
+    s->colUsed[s->colOf[idx]] &= bit;
+    s->boxUsed[s->boxOf[idx]] &= bit;
+}
+
+/* Returns the bitmask of values not used in any of the cell's units */
+unsigned long bit_candidates(bitSolver* s, int idx) {
+    return s->fullMask & ~(s->rowUsed[s->rowOf[idx]] | s->colUsed[s->colOf[idx]] | s->boxUsed[s->boxOf[idx]]);
+}
+
+/* Places a loaded value, returns false if value is already used in one of the cell's units */
+bool load_value(bitSolver* s, int idx, int val) {
+    if ((bit_candidates(s, idx) & (1UL << (val - 1))) == 0) {
+        return false;
+    }
+    bit_place(s, idx, val);
+    return true;
+}
+
+/* Loads a sudoku board of the global dimensions into the search context */
+bool bit_load_board(bitSolver* s, cell** board) {
+    int i, j, val;
+    bool valid = true;
+    if (!bit_init(s, blockRows, blockCols)) {
+        return false;
+    }
+    for (i = 0; i < s->N; i++) {
+        for (j = 0; j < s->N; j++) {
+            val = board[i][j].number;
+            if (val != UNASSIGNED && !load_value(s, i * s->N + j, val)) {
+                s->grid[i * s->N + j] = val; /* keeping the value so the grid mirrors the board */
+                valid = false;
+            }
+        }
+    }
+    return valid;
+}
+
+/* Copies the search context values into the given sudoku board */
+void bit_store_board(bitSolver* s, cell** board) {
+    int i, j;
+    for (i = 0; i < s->N; i++) {
+        for (j = 0; j < s->N; j++) {
+            board[i][j].number = s->grid[i * s->N + j];
+        }
+    }
+}
+
+/* Returns the value a symbol represents, 0 for an empty cell or -1 for an illegal symbol */
+int symbol_value(char symbol) {
+    if (symbol == '0' || symbol == '.') {
+        return UNASSIGNED;
+    }
+    if (symbol >= '1' && symbol <= '9') {
+        return symbol - '0';
+    }
+    if (symbol >= 'A' && symbol <= 'Z') {
+        return symbol - 'A' + 10;
+    }
+    if (symbol >= 'a' && symbol <= 'z') {
+        return symbol - 'a' + 10;
+    }
+    return -1;
+}
+
+/* Returns the block rows of an N symbols board: the largest divisor of N not above its square root gives the most square block */
+int infer_block_rows(int N) {
+    int rows;
+    for (rows = 1; (rows + 1) * (rows + 1) <= N; rows++);
+    while (N % rows != 0) {
+        rows--;
+    }
+    return rows;
+}
+
+/* Loads a one-line board representation, inferring the block dimensions from its length if needed */
+bool bit_load_string(bitSolver* s, const char* line, int rows, int cols) {
+    int idx, val, N, length = 0;
+    while (line[length] != '\0' && line[length] != '\n' && line[length] != '\r'
+           && line[length] != ' ' && line[length] != '\t') {
+        length++;
+    }
+    if (rows == 0) {
+        for (N = 1; N * N < length; N++);
+        if (N * N != length) {
+            return false;
+        }
+        rows = infer_block_rows(N);
+        cols = N / rows;
+    }
+    if (!bit_init(s, rows, cols) || length != s->size) {
+        return false;
+    }
+    for (idx = 0; idx < s->size; idx++) {
+        val = symbol_value(line[idx]);
+        if (val < 0 || val > s->N) {
+            return false;
+        }
+        if (val != UNASSIGNED && !load_value(s, idx, val)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Writes the one-line representation of the given cell values */
+void bit_format_values(const int* values, int size, char* out) {
+    int idx, val;
+    for (idx = 0; idx < size; idx++) {
+        val = values[idx];
+        if (val == UNASSIGNED) {
+            out[idx] = '0';
+        } else if (val < 10) {
+            out[idx] = (char) ('0' + val);
+        } else {
+            out[idx] = (char) ('A' + val - 10);
+        }
+    }
+    out[size] = '\0';
+}
+
+/* Writes the one-line board representation of the search context */
+void bit_format_string(bitSolver* s, char* out) {
+    bit_format_values(s->grid, s->size, out);
+}
+
+/* Starts a new search over the cells which are currently empty */
+void bit_search_begin(bitSolver* s) {
+    int idx;
+    s->emptyCount = 0;
+    for (idx = 0; idx < s->size; idx++) {
+        if (s->grid[idx] == UNASSIGNED) {
+            s->emptyList[s->emptyCount] = idx;
+            s->emptyCount++;
+        }
+    }
+    s->depth = 0;
+    s->prefixCount = 0;
+    s->freeDigits = 0;
+    s->nodes = 0;
+    s->state = SEARCH_DESCEND;
+}
+
+/* Moves the empty cells of the row with the fewest empty cells to the start of the empty cells list, keeping their
+ * column order, so the free digits are placed on them in increasing order */
+int bit_search_canonical(bitSolver* s) {
+    int k, idx, row, best = 0, count, bestCount = s->N + 1, moved = 0, freeCount = 0;
+    unsigned long used = 0, freeMask = 0, rest;
+    for (row = 0; row < s->N; row++) {
+        used |= s->rowUsed[row];
+    }
+    for (rest = s->fullMask & ~used; rest != 0 && freeCount < CANONICAL_MAX_FREE; rest &= rest - 1) {
+        freeMask |= rest & (~rest + 1);
+        freeCount++;
+    }
+    if (freeCount < 2) {
+        return freeCount;
+    }
+    for (row = 0; row < s->N; row++) {
+        count = s->N - count_bits(s->rowUsed[row]);
+        if (count < bestCount) {
+            best = row;
+            bestCount = count;
+        }
+    }
+    for (k = 0; k < s->emptyCount; k++) { /* the list is in row-major order, so the row cells stay in column order */
+        idx = s->emptyList[k];
+        if (s->rowOf[idx] == best) {
+            s->emptyList[k] = s->emptyList[moved];
+            s->emptyList[moved] = idx;
+            moved++;
+        }
+    }
+    s->prefixCount = moved;
+    s->freeDigits = freeMask;
+    return freeCount;
+}
+
+/* Moves the empty cell at position k of the empty cells list to position depth */
+void move_to_depth(bitSolver* s, int k) {
+    int idx = s->emptyList[s->depth];
+    s->emptyList[s->depth] = s->emptyList[k];
+    s->emptyList[k] = idx;
+}
+
+/* Looks for a unit value which has a single possible cell (hidden single) and moves that cell to position depth.
+ * once and twice hold, per unit, the values possible in at least one and in at least two of its empty cells.
+ * returns the forced value bit, 0 if some unit value has no possible cell (dead end) or ~0 if nothing was found */
+unsigned long pick_hidden_single(bitSolver* s, unsigned long* used, unsigned char* unitOf,
+                                 unsigned long* once, unsigned long* twice) {
+    int unit, k;
+    unsigned long required, hidden;
+    for (unit = 0; unit < s->N; unit++) {
+        required = s->fullMask & ~used[unit];
+        if ((required & ~once[unit]) != 0) {
+            return 0;
+        }
+        hidden = required & ~twice[unit];
+        if (hidden != 0) {
+            hidden &= ~hidden + 1;
+            for (k = s->depth; k < s->emptyCount; k++) {
+                if (unitOf[s->emptyList[k]] == unit && (bit_candidates(s, s->emptyList[k]) & hidden) != 0) {
+                    move_to_depth(s, k);
+                    return hidden;
+                }
+            }
+        }
+    }
+    return ~0UL;
+}
+
+/* Chooses the next cell to branch on and moves it to position depth of the empty cells list:
+ * a cell with a single candidate, else a value with a single possible cell in a unit,
+ * else the cell with the fewest candidates. returns the candidates to try, 0 on a dead end */
+unsigned long pick_cell(bitSolver* s) {
+    int k, idx, bits, best = s->depth, bestBits = MAX_BOARD_SIZE + 1;
+    unsigned long mask, bestMask = 0;
+    unsigned long once[3][MAX_BOARD_SIZE], twice[3][MAX_BOARD_SIZE]; /* per row, column and box */
+    memset(once, 0, sizeof(once));
+    memset(twice, 0, sizeof(twice));
+    for (k = s->depth; k < s->emptyCount; k++) {
+        idx = s->emptyList[k];
+        mask = bit_candidates(s, idx);
+        bits = count_bits(mask);
+        if (bits < bestBits) {
+            best = k;
+            bestBits = bits;
+            bestMask = mask;
+            if (bits <= 1) { /* a dead end or a forced cell can't be improved on */
+                move_to_depth(s, best);
+                return bestMask;
+            }
+        }
+        twice[0][s->rowOf[idx]] |= once[0][s->rowOf[idx]] & mask;
+        once[0][s->rowOf[idx]] |= mask;
+        twice[1][s->colOf[idx]] |= once[1][s->colOf[idx]] & mask;
+        once[1][s->colOf[idx]] |= mask;
+        twice[2][s->boxOf[idx]] |= once[2][s->boxOf[idx]] & mask;
+        once[2][s->boxOf[idx]] |= mask;
+    }
+    if ((mask = pick_hidden_single(s, s->rowUsed, s->rowOf, once[0], twice[0])) != ~0UL
+        || (mask = pick_hidden_single(s, s->colUsed, s->colOf, once[1], twice[1])) != ~0UL
+        || (mask = pick_hidden_single(s, s->boxUsed, s->boxOf, once[2], twice[2])) != ~0UL) {
+        return mask;
+    }
+    move_to_depth(s, best);
+    return bestMask;
+}
+
+/* Returns the candidates of the next cell of the canonical row: the digits which aren't free,
+ * and the smallest free digit the row misses */
+unsigned long pick_canonical(bitSolver* s) {
+    int idx = s->emptyList[s->depth];
+    unsigned long missing = s->freeDigits & ~s->rowUsed[s->rowOf[idx]];
+    return bit_candidates(s, idx) & ((s->fullMask & ~s->freeDigits) | (missing & (~missing + 1)));
+}
+
+/* Chooses the branching cell of the search root the way the search does, without searching */
+unsigned long bit_branch(bitSolver* s, int* idx) {
+    unsigned long mask;
+    bit_search_begin(s);
+    *idx = -1;
+    mask = (s->emptyCount > 0) ? pick_cell(s) : 0;
+    if (s->emptyCount > 0) {
+        *idx = s->emptyList[0];
+    }
+    s->state = SEARCH_IDLE;
+    return mask;
+}
+
+/* Continues the depth first search until the next solution, the end of the search space, the node limit or a stop request.
+ * the nodes, backtracks and eliminations of the call are added to the process counters when it returns */
+int bit_search_next(bitSolver* s) {
+    int top, idx, status;
+    unsigned long mask, bit;
+#ifndef SUDOKU_NO_STATS
+    long startNodes = s->nodes, backtracks = 0, eliminations = 0;
+#endif
+    if (s->state == SEARCH_IDLE) {
+        return SEARCH_DONE;
+    }
+    while (true) {
+        if (s->state == SEARCH_DESCEND) {
+            if ((s->nodeLimit > 0 && s->nodes >= s->nodeLimit) || (s->stop != NULL && *s->stop)) {
+                status = SEARCH_STOPPED;
+                break;
+            }
+            s->nodes++;
+            s->state = SEARCH_ADVANCE;
+            s->found = 1;
+            if (s->depth == s->emptyCount
+                || (s->table != NULL && count_table_probe(s->table, s) && s->found > 0)) {
+                if (s->table != NULL) {
+                    s->table->solutions = bit_count_add(s->table->solutions, 1, s->found);
+                }
+                status = SEARCH_FOUND;
+                break;
+            }
+            if (s->found == 0) { /* a stored state without solutions */
+                mask = 0;
+            } else {
+                mask = (s->depth < s->prefixCount) ? pick_canonical(s) : pick_cell(s);
+            }
+#ifndef SUDOKU_NO_STATS
+            if (mask != 0 && (mask & (mask - 1)) == 0 && s->depth >= s->prefixCount) { /* a hidden single */
+                eliminations += count_bits(bit_candidates(s, s->emptyList[s->depth])) - 1;
+            }
+#endif
+            if (mask != 0) { /* opening a new level, a dead end falls through to the next candidate of the current level */
+                s->levelLeft[s->depth] = mask;
+                s->levelVal[s->depth] = UNASSIGNED;
+                s->levelCount[s->depth] = (unsigned char) count_bits(mask);
+                s->depth++;
+            }
+        }
+        if (s->depth == 0) {
+            s->state = SEARCH_IDLE;
+            status = SEARCH_DONE;
+            break;
+        }
+        top = s->depth - 1;
+        idx = s->emptyList[top];
+        if (s->levelVal[top] != UNASSIGNED) {
+            bit_remove(s, idx);
+            s->levelVal[top] = UNASSIGNED;
+        }
+        if (s->levelLeft[top] == 0) { /* level exhausted */
+            if (s->table != NULL) {
+                count_table_close(s->table, s, top);
+            }
+#ifndef SUDOKU_NO_STATS
+            backtracks++;
+#endif
+            s->depth--;
+            continue;
+        }
+        if (s->randomOrder) {
+            bit = random_bit(&s->rng, s->levelLeft[top]);
+        } else {
+            bit = s->levelLeft[top] & (~s->levelLeft[top] + 1);
+        }
+        s->levelLeft[top] &= ~bit;
+        s->levelVal[top] = lowest_bit_index(bit) + 1;
+        bit_place(s, idx, s->levelVal[top]);
+        s->state = SEARCH_DESCEND;
+    }
+    STATS_ADD(searchNodes, s->nodes - startNodes);
+    STATS_ADD(backtracks, backtracks);
+    STATS_ADD(eliminations, eliminations);
+    return status;
+}
+
+/* Writes the search state as text: the board without the search values, the order of the empty cells
+ * and the open levels, which is all a depth first search needs to go on */
+bool bit_search_save(bitSolver* s, FILE* fp) {
+    int base[MAX_BOARD_CELLS];
+    char line[MAX_BOARD_CELLS + 1];
+    int k, top;
+    for (k = 0; k < s->size; k++) {
+        base[k] = s->grid[k];
+    }
+    for (top = 0; top < s->depth; top++) {
+        base[s->emptyList[top]] = UNASSIGNED;
+    }
+    bit_format_values(base, s->size, line);
+    fprintf(fp, "%d %d %d %d %d %ld\n%s\n", s->blockRows, s->blockCols, s->emptyCount, s->depth, s->state, s->nodes, line);
+    for (k = 0; k < s->emptyCount; k++) {
+        fprintf(fp, "%d%c", s->emptyList[k], (k + 1 < s->emptyCount) ? ' ' : '\n');
+    }
+    for (top = 0; top < s->depth; top++) {
+        fprintf(fp, "%lu %d %d\n", s->levelLeft[top], s->levelVal[top], s->levelCount[top]);
+    }
+    return !ferror(fp);
+}
+
+/* Reads a search state written by bit_search_save, checking it belongs to the board of the context and is a state
+ * the search can reach: the empty cells listed once each, and every level made of candidates of its cell.
+ * places the values of its open levels again */
+bool bit_search_load(bitSolver* s, FILE* fp) {
+    char line[MAX_BOARD_CELLS + 2], current[MAX_BOARD_CELLS + 1];
+    bool listed[MAX_BOARD_CELLS];
+    int rows, cols, emptyCount, depth, state, k, count, unassigned = 0;
+    unsigned long cand, bit;
+    long nodes;
+    if (fscanf(fp, "%d %d %d %d %d %ld %1025s", /* width of MAX_BOARD_CELLS + 1 to notice a longer board */&rows, &cols, &emptyCount, &depth, &state, &nodes, line) != 7
+        || rows != s->blockRows || cols != s->blockCols || emptyCount < 0 || emptyCount > s->size
+        || depth < 0 || depth > emptyCount || (state != SEARCH_DESCEND && state != SEARCH_ADVANCE)) {
+        return false;
+    }
+    bit_format_string(s, current);
+    if (strcmp(line, current) != 0) { /* another board */
+        return false;
+    }
+    for (k = 0; k < s->size; k++) {
+        listed[k] = false;
+        if (s->grid[k] == UNASSIGNED) {
+            unassigned++;
+        }
+    }
+    if (emptyCount != unassigned) {
+        return false;
+    }
+    for (k = 0; k < emptyCount; k++) {
+        if (fscanf(fp, "%d", &s->emptyList[k]) != 1 || s->emptyList[k] < 0 || s->emptyList[k] >= s->size
+            || s->grid[s->emptyList[k]] != UNASSIGNED || listed[s->emptyList[k]]) {
+            return false;
+        }
+        listed[s->emptyList[k]] = true;
+    }
+    s->emptyCount = emptyCount;
+    s->prefixCount = 0;
+    s->freeDigits = 0;
+    s->depth = 0;
+    for (k = 0; k < depth; k++) {
+        if (fscanf(fp, "%lu %d %d", &s->levelLeft[k], &s->levelVal[k], &count) != 3
+            || s->levelVal[k] < 0 || s->levelVal[k] > s->N || count < 1 || count > s->N) {
+            bit_search_end(s);
+            return false;
+        }
+        /* only the top level may be between values, and a level holds untried candidates of its cell
+         * besides its current value */
+        cand = bit_candidates(s, s->emptyList[k]);
+        bit = (s->levelVal[k] != UNASSIGNED) ? 1UL << (s->levelVal[k] - 1) : 0;
+        if ((s->levelVal[k] == UNASSIGNED && (k + 1 < depth || state == SEARCH_DESCEND))
+            || (s->levelLeft[k] & ~cand) != 0 || (bit & ~cand) != 0 || (bit & s->levelLeft[k]) != 0
+            || count_bits(s->levelLeft[k]) + ((bit != 0) ? 1 : 0) > count || count > count_bits(cand)) {
+            bit_search_end(s);
+            return false;
+        }
+        s->levelCount[k] = (unsigned char) count;
+        s->depth++;
+        if (bit != 0) {
+            bit_place(s, s->emptyList[k], s->levelVal[k]);
+        }
+    }
+    s->state = state;
+    s->nodes = nodes;
+    return true;
+}
+
+/* Sums the shares of the finished branches on the current path, a branch of a level with k candidates
+ * weighs 1/k of the branch above it */
+double bit_search_progress(bitSolver* s) {
+    double fraction = 0.0, weight = 1.0;
+    int top, finished;
+    if (s->state == SEARCH_IDLE) {
+        return 1.0;
+    }
+    for (top = 0; top < s->depth; top++) {
+        finished = s->levelCount[top] - count_bits(s->levelLeft[top]) - ((s->levelVal[top] != UNASSIGNED) ? 1 : 0);
+        fraction += weight * finished / s->levelCount[top];
+        weight /= s->levelCount[top];
+    }
+    return fraction;
+}
+
+/* Ends the search by removing all the values placed by it */
+void bit_search_end(bitSolver* s) {
+    int top;
+    for (top = s->depth - 1; top >= 0; top--) {
+        if (s->levelVal[top] != UNASSIGNED) {
+            bit_remove(s, s->emptyList[top]);
+            s->levelVal[top] = UNASSIGNED;
+        }
+    }
+    s->depth = 0;
+    s->state = SEARCH_IDLE;
+}
+
+/* Solves the board, leaving the first solution found in the grid */
+bool bit_solve(bitSolver* s) {
+    bit_search_begin(s);
+    if (bit_search_next(s) == SEARCH_FOUND) {
+        s->state = SEARCH_IDLE; /* keeping the solution values in the grid */
+        return true;
+    }
+    bit_search_end(s);
+    return false;
+}
+
+/* Counts solutions up to limit (0 for no limit), leaving the grid unchanged */
+long bit_count(bitSolver* s, long limit) {
+    long counter = 0;
+    bit_search_begin(s);
+    while (bit_search_next(s) == SEARCH_FOUND) {
+        counter++;
+        if (limit > 0 && counter >= limit) {
+            break;
+        }
+    }
+    bit_search_end(s);
+    return counter;
+}
+
+/* Adds orbit * found to count, saturating at LONG_MAX */
+long bit_count_add(long count, long orbit, long found) {
+    if (found > 0 && orbit > (LONG_MAX - count) / found) {
+        return LONG_MAX;
+    }
+    return count + orbit * found;
+}
+
+/* Follows a single random path of the search tree, branching like bit_search_next, leaving the grid unchanged.
+ * the product of the branching factors on the path is Knuth's estimate of the tree size */
+bool bit_probe(bitSolver* s, double* logWeight) {
+    unsigned long mask;
+    bool found = true;
+    int top;
+    long nodes = s->nodes;
+    *logWeight = 0.0;
+    bit_search_begin(s); /* listing the empty cells */
+    s->nodes = nodes;
+    while (s->depth < s->emptyCount) {
+        s->nodes++;
+        mask = pick_cell(s);
+        if (mask == 0) { /* dead end */
+            found = false;
+            break;
+        }
+        *logWeight += log((double) count_bits(mask));
+        bit_place(s, s->emptyList[s->depth], lowest_bit_index(random_bit(&s->rng, mask)) + 1);
+        s->depth++;
+    }
+    for (top = s->depth - 1; top >= 0; top--) {
+        bit_remove(s, s->emptyList[top]);
+    }
+    s->depth = 0;
+    s->state = SEARCH_IDLE;
+    return found;
+}
@@ -0,0 +1,304 @@
+/** @file bit_solver.h
+ *  @brief bit solver header file.
+ *
+ *  This header contains the prototypes for the bit solver module.
+ *  contains the structure definition of a reentrant bitmask search context.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_BIT_SOLVER_H
+#define SUDOKU_BIT_SOLVER_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include "prng.h"
+#include <stdio.h>
+
+
+/* -- Defines -- */
+#define MAX_BOARD_SIZE 32 /* largest N = blockRows * blockCols a candidate mask can hold */
+#define MAX_BOARD_CELLS (MAX_BOARD_SIZE * MAX_BOARD_SIZE)
+
+#define CANONICAL_MAX_FREE 12 /* free digits relabeled at most, 12! is the largest factorial a 32 bit long holds */
+
+#define SEARCH_FOUND 1
+#define SEARCH_DONE 0
+#define SEARCH_STOPPED (-1)
+
+
+/* -- Structs -- */
+
+struct countTable;
+
+/**
+ * @brief bitSolver structure representing a self contained sudoku search context.
+ * bitSolver does not use the global board dimensions, so several contexts can be used at once (one per thread).
+ * bitSolver contains blockRows, blockCols, N and size fields describing the board dimensions (size = N * N).
+ * bitSolver contains grid field containing the cell values in row-major order (UNASSIGNED for empty cells).
+ * bitSolver contains rowUsed, colUsed and boxUsed fields containing a bitmask of the values used in every unit,
+ * value v is represented by bit v - 1.
+ * bitSolver contains rowOf, colOf and boxOf fields mapping every cell index to its units.
+ * bitSolver contains emptyList field containing the cells which were empty when the search began,
+ * the first depth entries are the cells currently assigned by the search.
+ * bitSolver contains levelLeft and levelVal fields holding, per search depth, the candidates not tried yet
+ * and the value currently placed (0 if none), and levelCount field the amount of candidates the level opened with.
+ * bitSolver contains prefixCount field, the amount of empty cells at the start of emptyList which are searched in
+ * order before the others, and freeDigits field, the digits which must appear in increasing order on those cells
+ * (see bit_search_canonical).
+ * bitSolver contains table field pointing to the transposition table of a counting search (NULL for none),
+ * and found field, the amount of solutions the last SEARCH_FOUND stands for: 1, or the stored count of a state.
+ * bitSolver contains nodes field counting the search nodes visited and nodeLimit field (0 for no limit).
+ * bitSolver contains stop field pointing to a flag which stops the search when set by another thread (NULL for none).
+ * bitSolver contains randomOrder field, when true the candidates of a cell are tried in random order.
+ * bitSolver contains rng field, the generator used for random choices, which bit_init() does not reset.
+ *
+ */
+typedef struct bitSolver {
+    int blockRows;
+    int blockCols;
+    int N;
+    int size;
+    unsigned long fullMask;
+    int grid[MAX_BOARD_CELLS];
+    unsigned long rowUsed[MAX_BOARD_SIZE];
+    unsigned long colUsed[MAX_BOARD_SIZE];
+    unsigned long boxUsed[MAX_BOARD_SIZE];
+    unsigned char rowOf[MAX_BOARD_CELLS];
+    unsigned char colOf[MAX_BOARD_CELLS];
+    unsigned char boxOf[MAX_BOARD_CELLS];
+    int emptyCount;
+    int emptyList[MAX_BOARD_CELLS];
+    int depth;
+    int state;
+    unsigned long levelLeft[MAX_BOARD_CELLS];
+    int levelVal[MAX_BOARD_CELLS];
+    unsigned char levelCount[MAX_BOARD_CELLS];
+    int prefixCount;
+    unsigned long freeDigits;
+    struct countTable* table;
+    long found;
+    long nodes;
+    long nodeLimit;
+    volatile bool* stop;
+    bool randomOrder;
+    prng rng;
+} bitSolver;
+
+
+/** @brief Returns the amount of bits set in given mask.
+ *  @param mask bitmask.
+ *  @return amount of set bits.
+ */
+int count_bits(unsigned long mask);
+
+
+/** @brief Returns the index of the lowest bit set in given mask.
+ *  @param mask non zero bitmask.
+ *  @return bit index, value v is represented by index v - 1.
+ */
+int lowest_bit_index(unsigned long mask);
+
+
+/** @brief Returns one of the bits set in given mask, chosen uniformly at random.
+ *  @param r generator.
+ *  @param mask non zero bitmask.
+ *  @return mask containing only the chosen bit.
+ */
+unsigned long random_bit(prng* r, unsigned long mask);
+
+
+/** @brief Initializes an empty search context for a board with the given block dimensions.
+ *  @param s search context to initialize.
+ *  @param rows block rows.
+ *  @param cols block columns.
+ *  @return true if the dimensions are supported, else false.
+ */
+bool bit_init(bitSolver* s, int rows, int cols);
+
+
+/** @brief Places given value in given cell and updates the unit masks.
+ *  @param s search context.
+ *  @param idx cell index in row-major order.
+ *  @param val value between 1-N.
+ *  @return void.
+ */
+void bit_place(bitSolver* s, int idx, int val);
+
+
+/** @brief Removes the value of given cell and updates the unit masks.
+ *  @param s search context.
+ *  @param idx cell index in row-major order.
+ *  @return void.
+ */
+void bit_remove(bitSolver* s, int idx);
+
+
+/** @brief Returns the bitmask of values which can be legally placed in given cell.
+ *  @param s search context.
+ *  @param idx cell index in row-major order.
+ *  @return candidates bitmask.
+ */
+unsigned long bit_candidates(bitSolver* s, int idx);
+
+
+/** @brief Loads a sudoku board of the global board dimensions into given search context.
+ *  @param s search context, initialized with the global dimensions.
+ *  @param board sudoku board to load, remains unchanged.
+ *  @return true if the board values don't conflict, else false.
+ */
+bool bit_load_board(bitSolver* s, cell** board);
+
+
+/** @brief Copies the search context values into given sudoku board of the global board dimensions.
+ *  @param s search context.
+ *  @param board sudoku board to be updated, fixation and asterisks remain unchanged.
+ *  @return void.
+ */
+void bit_store_board(bitSolver* s, cell** board);
+
+
+/** @brief Returns the block rows of a board with given amount of symbols, the block columns are N / rows.
+ *  the most square block is chosen: the largest divisor of N which is not above its square root.
+ *  @param N amount of symbols.
+ *  @return block rows.
+ */
+int infer_block_rows(int N);
+
+
+/** @brief Loads a one-line board representation into given search context.
+ *  the line contains N * N symbols: '0' or '.' for an empty cell, '1'-'9' and then 'A'-'Z' for values.
+ *  the block dimensions are inferred from the line length when rows is 0.
+ *  @param s search context to initialize.
+ *  @param line board representation, may end with white spaces.
+ *  @param rows block rows or 0 to infer.
+ *  @param cols block columns, ignored when rows is 0.
+ *  @return true if the line is a valid board without conflicting values, else false.
+ */
+bool bit_load_string(bitSolver* s, const char* line, int rows, int cols);
+
+
+/** @brief Writes the one-line representation of given cell values into given buffer.
+ *  @param values cell values in row-major order, UNASSIGNED for an empty cell.
+ *  @param size amount of cells.
+ *  @param out buffer of at least size + 1 chars.
+ *  @return void.
+ */
+void bit_format_values(const int* values, int size, char* out);
+
+
+/** @brief Writes the one-line representation of the search context values into given buffer.
+ *  @param s search context.
+ *  @param out buffer of at least size + 1 chars.
+ *  @return void.
+ */
+void bit_format_string(bitSolver* s, char* out);
+
+
+/** @brief Starts a new depth first search over the empty cells of given search context.
+ *  @param s search context.
+ *  @return void.
+ */
+void bit_search_begin(bitSolver* s);
+
+
+/** @brief Returns the cell the search of given search context would branch on first, and its candidates.
+ *  @param s search context, not searching.
+ *  @param idx to be updated with the cell index, -1 if the board is full.
+ *  @return the candidates the search would try in that cell, 0 if the board is full or has no solution.
+ */
+unsigned long bit_branch(bitSolver* s, int* idx);
+
+
+/** @brief Restricts the search begun on given search context to canonical solutions up to relabeling of the free digits,
+ *  the digits which don't appear on the board. relabeling them maps solutions to solutions, and every solution has
+ *  exactly one relabeling where they appear in increasing order along the row with the fewest empty cells,
+ *  so every solution found stands for k! solutions, where k is the amount of free digits (at most CANONICAL_MAX_FREE
+ *  of them are used). that row is searched first, cell by cell, allowing only the smallest free digit it misses.
+ *  @param s search context, right after bit_search_begin.
+ *  @return the amount of free digits used k, the search is unchanged when k is below 2.
+ */
+int bit_search_canonical(bitSolver* s);
+
+
+/** @brief Continues the search until the next solution.
+ *  when a solution is found the grid holds it until the next call. with a transposition table, a state whose count
+ *  is stored is found as a whole: the grid then holds the state and the found field its count.
+ *  @param s search context.
+ *  @return SEARCH_FOUND, SEARCH_DONE when the search space is exhausted,
+ *  or SEARCH_STOPPED when nodeLimit was reached or the stop flag was set.
+ */
+int bit_search_next(bitSolver* s);
+
+
+/** @brief Writes the state of the search of given search context as text, so it can go on in another run.
+ *  the state takes O(depth) space besides the board: the order of the empty cells and the open levels.
+ *  @param s search context, searching.
+ *  @param fp file opened for writing.
+ *  @return true on success, false if writing failed.
+ */
+bool bit_search_save(bitSolver* s, FILE* fp);
+
+
+/** @brief Restores a search state written by bit_search_save, the search then goes on from where it was saved.
+ *  @param s search context holding the board the state was saved with, not searching.
+ *  @param fp file opened for reading, positioned at the state.
+ *  @return true on success, false if the state is malformed, belongs to another board or holds values which aren't
+ *  candidates of their cells (the context is then left not searching).
+ */
+bool bit_search_load(bitSolver* s, FILE* fp);
+
+
+/** @brief Returns the fraction of the search tree explored so far, where every branch of a node
+ *  weighs the same share of its parent. the fraction is exact when the search is done.
+ *  @param s search context.
+ *  @return fraction between 0 and 1.
+ */
+double bit_search_progress(bitSolver* s);
+
+
+/** @brief Ends the search by removing every value placed by it.
+ *  @param s search context.
+ *  @return void.
+ */
+void bit_search_end(bitSolver* s);
+
+
+/** @brief Solves the board in given search context, the grid holds the solution on success.
+ *  @param s search context.
+ *  @return true if solvable, else false.
+ */
+bool bit_solve(bitSolver* s);
+
+
+/** @brief Counts the solutions of the board in given search context, the grid remains unchanged.
+ *  @param s search context.
+ *  @param limit stop counting after limit solutions, 0 for no limit.
+ *  @return number of solutions found.
+ */
+long bit_count(bitSolver* s, long limit);
+
+
+/** @brief Adds orbit * found solutions to a count without overflowing: a count which doesn't fit a long is LONG_MAX.
+ *  @param count solutions counted so far, 0-LONG_MAX.
+ *  @param orbit solutions each found solution stands for, 0-LONG_MAX.
+ *  @param found solutions found, 0-LONG_MAX.
+ *  @return the new count, LONG_MAX if it overflows.
+ */
+long bit_count_add(long count, long orbit, long found);
+
+
+/** @brief Follows a single random path of the search tree of given search context, choosing the cells like the search
+ *  and a uniformly random candidate of each, until a solution or a dead end. the grid remains unchanged.
+ *  the expected value of the product of the candidate amounts on the path, counting dead ends as 0,
+ *  is the number of solutions (Knuth's estimator).
+ *  @param s search context, not searching.
+ *  @param logWeight to be updated with the natural log of the product of the candidate amounts on the path.
+ *  @return true if the path reached a solution, false if it reached a dead end.
+ */
+bool bit_probe(bitSolver* s, double* logWeight);
+
+
+#endif /*SUDOKU_BIT_SOLVER_H*/
@@ -0,0 +1,57 @@
+/** @file board_file.c
+ *  @brief board file source file.
+ *
+ *  This module reads and writes board files cell by cell, so the game, which keeps boards of any dimensions as cell
+ *  rows, and libsudoku, which keeps them as value arrays, share one implementation of the format: a line with the
+ *  block rows and columns, then N lines of N values separated by whitespace, a value followed by '.' is fixed and one
+ *  followed by '*' erroneous. It uses no global state and prints nothing.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "board_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* Reads the dimensions and checks N is within the given size */
+bool board_file_read_header(FILE* fp, int maxSize, int* blockRows, int* blockCols) {
+    if (fscanf(fp, "%d %d", blockRows, blockCols) != 2 || *blockRows < 1 || *blockCols < 1) {
+        return false;
+    }
+    return *blockRows <= maxSize / *blockCols; /* blockRows * blockCols <= maxSize without overflow */
+}
+
+/* Reads the next whitespace separated token as a value and its optional mark */
+bool board_file_read_cell(FILE* fp, int N, int* value, char* mark) {
+    char token[BOARD_FILE_TOKEN_SIZE];
+    char* end;
+    long val;
+    if (fscanf(fp, "%15s", token) != 1) {
+        return false;
+    }
+    val = strtol(token, &end, 10);
+    if (end == token || val < 0 || val > N || (*end != '\0' && strcmp(end, ".") != 0 && strcmp(end, "*") != 0)) {
+        return false;
+    }
+    *value = (int) val;
+    *mark = *end;
+    return true;
+}
+
+/* Writes the dimensions line */
+bool board_file_write_header(FILE* fp, int blockRows, int blockCols) {
+    return fprintf(fp, "%d %d\n", blockRows, blockCols) > 0;
+}
+
+/* Writes the value, its fixed mark and a separator */
+bool board_file_write_cell(FILE* fp, int value, bool fixed, bool endOfRow) {
+    if (fprintf(fp, "%d%s ", value, (fixed && value != UNASSIGNED) ? "." : "") < 0) {
+        return false;
+    }
+    return !endOfRow || fprintf(fp, "\n") > 0;
+}
@@ -0,0 +1,64 @@
+/** @file board_file.h
+ *  @brief board file header file.
+ *
+ *  This header contains the prototypes for the board file module, which reads and writes the board files of the
+ *  save, edit and solve commands.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_BOARD_FILE_H
+#define SUDOKU_BOARD_FILE_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include <stdio.h>
+
+
+/* -- Defines -- */
+#define BOARD_FILE_MAX_SIZE 99 /* largest N = blockRows * blockCols of a board file, values have up to two digits */
+#define BOARD_FILE_TOKEN_SIZE 16 /* longest cell read, with its mark */
+
+
+/** @brief Reads the first line of a board file, the block rows and columns.
+ *  @param fp file open for reading.
+ *  @param maxSize largest N = blockRows * blockCols accepted.
+ *  @param blockRows to be updated with the rows of a block.
+ *  @param blockCols to be updated with the columns of a block.
+ *  @return true, or false if the file doesn't start with valid dimensions.
+ */
+bool board_file_read_header(FILE* fp, int maxSize, int* blockRows, int* blockCols);
+
+
+/** @brief Reads the next cell of a board file: its value, followed by '.' if it is fixed or '*' if it is erroneous.
+ *  @param fp file open for reading, after the header and the cells before.
+ *  @param N largest value.
+ *  @param value to be updated with the value of the cell, 0 if it is empty.
+ *  @param mark to be updated with the mark of the cell, '.', '*' or '\0' for none.
+ *  @return true, or false if the file ended or the cell is not a value 0-N with an optional mark.
+ */
+bool board_file_read_cell(FILE* fp, int N, int* value, char* mark);
+
+
+/** @brief Writes the first line of a board file, the block rows and columns.
+ *  @param fp file open for writing.
+ *  @param blockRows rows of a block.
+ *  @param blockCols columns of a block.
+ *  @return true, or false if writing failed.
+ */
+bool board_file_write_header(FILE* fp, int blockRows, int blockCols);
+
+
+/** @brief Writes the next cell of a board file, the last cell of a row ends the line.
+ *  @param fp file open for writing.
+ *  @param value value of the cell, 0 if it is empty.
+ *  @param fixed true to mark a non empty cell as fixed.
+ *  @param endOfRow true if the cell is the last of its row.
+ *  @return true, or false if writing failed.
+ */
+bool board_file_write_cell(FILE* fp, int value, bool fixed, bool endOfRow);
+
+
+#endif /*SUDOKU_BOARD_FILE_H*/
@@ -0,0 +1,184 @@
+/** @file cache.c
+ *  @brief cache source file.
+ *
+ *  This module implements the solution cache used by hint, validate and save, so repeated questions about the same
+ *  or a nearby position are answered without running a solver.
+ *  Positions are identified by a Zobrist hash: the xor of a pseudo random key per (cell, value) pair,
+ *  so a move updates the hash by xoring out the old value key and xoring in the new one.
+ *  The keys are computed by a mixing function instead of being kept in a table, so they need no setup per board size.
+ *  A hash match is always confirmed by comparing the board values with the cached solution.
+ *  The cache is shared by the threads of the process behind a lock, lookups copy the value they answer.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "cache.h"
+#include "main_aux.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* -- Defines -- */
+#define KEY_MASK 0xFFFFFFFFUL
+
+
+/* -- Global Variables  -- */
+extern __thread int blockRows;
+extern __thread int blockCols;
+
+cacheEntry solutionCache[SOLUTION_CACHE_SIZE];
+long cacheClock = 0;
+pthread_mutex_t cacheLock = PTHREAD_MUTEX_INITIALIZER;
+
+
+/* Returns the key of a value in a cell, a 32 bit mix of the pair */
+unsigned long zobrist_key(int idx, int val) {
+    unsigned long z;
+    if (val == UNASSIGNED) {
+        return 0;
+    }
+    z = ((unsigned long) idx * 0x9E3779B9UL + (unsigned long) val * 0x7F4A7C15UL) & KEY_MASK;
+    z = ((z ^ (z >> 16)) * 0x85EBCA6BUL) & KEY_MASK;
+    z = ((z ^ (z >> 13)) * 0xC2B2AE35UL) & KEY_MASK;
+    return z ^ (z >> 16);
+}
+
+/* Computes the hash of every value of the board */
+unsigned long board_hash(cell** board) {
+    int i, j;
+    int N = blockRows * blockCols;
+    unsigned long hash = 0;
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            hash ^= zobrist_key(i * N + j, board[i][j].number);
+        }
+    }
+    return hash;
+}
+
+/* Replaces the key of the old value of a cell by the key of its new value */
+void update_board_hash(int column, int row, int oldVal, int newVal) {
+    int idx = (row - 1) * blockRows * blockCols + (column - 1);
+    boardHash ^= zobrist_key(idx, oldVal) ^ zobrist_key(idx, newVal);
+}
+
+/* Returns true if every value of the board agrees with the cached solution */
+bool consistent_with(cell** board, cacheEntry* entry) {
+    int i, j;
+    int N = blockRows * blockCols;
+    if (entry->blockRows != blockRows || entry->blockCols != blockCols) {
+        return false;
+    }
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            if (board[i][j].number != UNASSIGNED && board[i][j].number != entry->solution[i * N + j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Looks for the same position first, then for the most recently used solution agreeing with the board */
+int cache_lookup(cell** board, unsigned long hash, int idx) {
+    int i, value, found = -1;
+    pthread_mutex_lock(&cacheLock);
+    for (i = 0; i < SOLUTION_CACHE_SIZE && found < 0; i++) {
+        if (solutionCache[i].hash == hash && consistent_with(board, &solutionCache[i])) {
+            found = i;
+        }
+    }
+    if (found < 0) {
+        for (i = 0; i < SOLUTION_CACHE_SIZE; i++) {
+            if ((found < 0 || solutionCache[i].lastUse > solutionCache[found].lastUse)
+                && consistent_with(board, &solutionCache[i])) {
+                found = i;
+            }
+        }
+    }
+    if (found < 0) {
+        pthread_mutex_unlock(&cacheLock);
+        return UNASSIGNED;
+    }
+    cacheClock++;
+    solutionCache[found].lastUse = cacheClock;
+    value = solutionCache[found].solution[idx];
+    pthread_mutex_unlock(&cacheLock);
+    return value;
+}
+
+/* Returns the solution buffer of the entry storing the given position: the entry already holding it,
+ * else an unused entry, else the least recently used one. called with the lock held */
+int* cache_slot(unsigned long hash) {
+    int i, slot = 0;
+    cacheEntry* entry;
+    for (i = 0; i < SOLUTION_CACHE_SIZE; i++) {
+        entry = &solutionCache[i];
+        if (entry->blockRows == blockRows && entry->blockCols == blockCols && entry->hash == hash) {
+            slot = i;
+            break;
+        }
+        if (solutionCache[slot].blockRows != 0 && (entry->blockRows == 0 || entry->lastUse < solutionCache[slot].lastUse)) {
+            slot = i;
+        }
+    }
+    entry = &solutionCache[slot];
+    if (entry->blockRows != blockRows || entry->blockCols != blockCols) { /* unused or of another board size */
+        free(entry->solution);
+        entry->solution = malloc(sizeof(int) * blockRows * blockCols * blockRows * blockCols);
+        if (entry->solution == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+        entry->blockRows = blockRows;
+        entry->blockCols = blockCols;
+    }
+    entry->hash = hash;
+    cacheClock++;
+    entry->lastUse = cacheClock;
+    return entry->solution;
+}
+
+/* Copies the solution values into a cache entry */
+void cache_store(unsigned long hash, const int* solution) {
+    int i;
+    int size = blockRows * blockCols * blockRows * blockCols;
+    int* values;
+    pthread_mutex_lock(&cacheLock);
+    values = cache_slot(hash);
+    for (i = 0; i < size; i++) {
+        values[i] = solution[i];
+    }
+    pthread_mutex_unlock(&cacheLock);
+}
+
+/* Copies the solved board values into a cache entry */
+void cache_store_board(unsigned long hash, cell** solution) {
+    int i, j;
+    int N = blockRows * blockCols;
+    int* values;
+    pthread_mutex_lock(&cacheLock);
+    values = cache_slot(hash);
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            values[i * N + j] = solution[i][j].number;
+        }
+    }
+    pthread_mutex_unlock(&cacheLock);
+}
+
+/* Frees the cached solutions and marks every entry unused */
+void cache_free() {
+    int i;
+    pthread_mutex_lock(&cacheLock);
+    for (i = 0; i < SOLUTION_CACHE_SIZE; i++) {
+        free(solutionCache[i].solution);
+        solutionCache[i].solution = NULL;
+        solutionCache[i].blockRows = 0;
+        solutionCache[i].blockCols = 0;
+    }
+    pthread_mutex_unlock(&cacheLock);
+}
@@ -0,0 +1,103 @@
+/** @file cache.h
+ *  @brief cache header file.
+ *
+ *  This header contains the prototypes for the solution cache module.
+ *  contains the structure definition of a cached solution.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_CACHE_H
+#define SUDOKU_CACHE_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+
+
+/* -- Defines -- */
+#define SOLUTION_CACHE_SIZE 16
+
+
+/* -- Structs -- */
+
+/**
+ * @brief cacheEntry structure representing a solved position kept by the solution cache.
+ * cacheEntry contains hash field containing the hash of the position which was solved.
+ * cacheEntry contains blockRows and blockCols fields containing the board dimensions, 0 for an unused entry.
+ * cacheEntry contains solution field containing the solution values in row-major order.
+ * cacheEntry contains lastUse field, the cache clock at the last store or lookup, the oldest entry is replaced first.
+ *
+ */
+typedef struct cacheEntry {
+    unsigned long hash;
+    int blockRows;
+    int blockCols;
+    int* solution;
+    long lastUse;
+} cacheEntry;
+
+
+/* -- Global Variables  -- */
+extern __thread unsigned long boardHash; /* hash of the game board, updated on every move */
+
+
+/** @brief Returns the Zobrist key of given value in given cell, the hash of a board is the xor of the keys of its values.
+ *  @param idx cell index in row-major order.
+ *  @param val cell value, UNASSIGNED has the key 0.
+ *  @return key.
+ */
+unsigned long zobrist_key(int idx, int val);
+
+
+/** @brief Computes the hash of a sudoku board of the global board dimensions from scratch.
+ *  @param board sudoku board, remains unchanged.
+ *  @return board hash.
+ */
+unsigned long board_hash(cell** board);
+
+
+/** @brief Updates the game board hash after the value of a cell was changed.
+ *  @param column column index between 1-N.
+ *  @param row row index between 1-N.
+ *  @param oldVal value before the change.
+ *  @param newVal value after the change.
+ *  @return void.
+ */
+void update_board_hash(int column, int row, int oldVal, int newVal);
+
+
+/** @brief Looks for a cached solution of given board: a solution of the same position (by hash)
+ *  or of any position whose values all agree with the board, which is then a solution of the board too.
+ *  @param board sudoku board of the global board dimensions, remains unchanged.
+ *  @param hash board hash.
+ *  @param idx cell index in row-major order whose solution value is returned.
+ *  @return value of the cell in the solution, UNASSIGNED if there is none.
+ */
+int cache_lookup(cell** board, unsigned long hash, int idx);
+
+
+/** @brief Stores the solution of a position in the cache, replacing the least recently used entry.
+ *  @param hash hash of the solved position.
+ *  @param solution solution values in row-major order, of the global board dimensions.
+ *  @return void.
+ */
+void cache_store(unsigned long hash, const int* solution);
+
+
+/** @brief Stores a solved sudoku board in the cache, replacing the least recently used entry.
+ *  @param hash hash of the solved position.
+ *  @param solution solved sudoku board of the global board dimensions.
+ *  @return void.
+ */
+void cache_store_board(unsigned long hash, cell** solution);
+
+
+/** @brief Frees the memory of the cached solutions.
+ *  @return void.
+ */
+void cache_free();
+
+
+#endif /*SUDOKU_CACHE_H*/
@@ -0,0 +1,120 @@
+/** @file count_table.c
+ *  @brief count table source file.
+ *
+ *  This module implements the transposition table of the solutions counting search. Once the search has assigned
+ *  enough cells, different paths often leave the same residual state: the same empty cells with the same candidates.
+ *  Its solutions count is the same whatever the path, so the count is stored when its subtree ends and a state
+ *  reached again is answered from the table instead of being searched again.
+ *  States are identified by two independent 32 bit hashes, the xor of a mix of every (cell, candidates) pair.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "count_table.h"
+#include "bit_solver.h"
+#include "main_aux.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* -- Defines -- */
+#define KEY_MASK 0xFFFFFFFFUL
+
+
+/* -- Global Variables  -- */
+__thread long countTableMegabytes = COUNT_TABLE_DEFAULT_MB;
+
+
+/* Returns a 32 bit mix of a cell, its candidates and a salt, which selects one of the two hashes */
+unsigned long state_key(int idx, unsigned long cand, unsigned long salt) {
+    unsigned long z;
+    z = ((unsigned long) idx * 0x9E3779B9UL + (cand & KEY_MASK) * 0x7F4A7C15UL + salt) & KEY_MASK;
+    z = ((z ^ (z >> 16)) * 0x85EBCA6BUL) & KEY_MASK;
+    z = ((z ^ (z >> 13)) * 0xC2B2AE35UL) & KEY_MASK;
+    return z ^ (z >> 16);
+}
+
+/* Allocates the largest power of 2 of buckets which fits the memory cap */
+void count_table_init(countTable* t, long megabytes) {
+    long bytes = megabytes * 1024 * 1024;
+    t->buckets = 1;
+    while (t->buckets * 2 * (long) sizeof(countEntry) * 2 <= bytes) {
+        t->buckets *= 2;
+    }
+    t->entries = calloc(t->buckets * 2, sizeof(countEntry));
+    if (t->entries == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    t->lookups = 0;
+    t->hits = 0;
+    t->stores = 0;
+    t->replacements = 0;
+    t->solutions = 0;
+}
+
+/* Frees the table entries */
+void count_table_free(countTable* t) {
+    free(t->entries);
+    t->entries = NULL;
+}
+
+/* Hashes the residual state when it is in the range worth storing, and looks it up in its bucket */
+bool count_table_probe(countTable* t, bitSolver* s) {
+    int k, idx, left = s->emptyCount - s->depth;
+    unsigned long cand, key = 0, check = (unsigned long) left;
+    countEntry* bucket;
+    t->levelMemo[s->depth] = false;
+    if (left < COUNT_TABLE_MIN_LEFT || s->depth < s->prefixCount) { /* the canonical row restricts its cells */
+        return false;
+    }
+    for (k = s->depth; k < s->emptyCount; k++) {
+        idx = s->emptyList[k];
+        cand = bit_candidates(s, idx);
+        key ^= state_key(idx, cand, 0);
+        check ^= state_key(idx, cand, 0x5BD1E995UL);
+    }
+    key |= 1; /* an unused entry has key 0 */
+    t->lookups++;
+    bucket = &t->entries[((key >> 1) & (t->buckets - 1)) * 2];
+    for (k = 0; k < 2; k++) {
+        if (bucket[k].key == key && bucket[k].check == check) {
+            t->hits++;
+            s->found = bucket[k].count;
+            return true;
+        }
+    }
+    t->levelMemo[s->depth] = true;
+    t->levelKey[s->depth] = key;
+    t->levelCheck[s->depth] = check;
+    t->levelSolutions[s->depth] = t->solutions;
+    t->levelNodes[s->depth] = s->nodes;
+    return false;
+}
+
+/* Stores the count of the ended level in its bucket: in the first entry if it took at least as much work as the one
+ * there, which moves to the second, otherwise in the second */
+void count_table_close(countTable* t, bitSolver* s, int level) {
+    countEntry entry;
+    countEntry* bucket;
+    if (!t->levelMemo[level]) {
+        return;
+    }
+    entry.key = t->levelKey[level];
+    entry.check = t->levelCheck[level];
+    entry.count = t->solutions - t->levelSolutions[level];
+    entry.work = s->nodes - t->levelNodes[level];
+    bucket = &t->entries[((entry.key >> 1) & (t->buckets - 1)) * 2];
+    if (bucket[1].key != 0) {
+        t->replacements++;
+    }
+    if (entry.work >= bucket[0].work) {
+        bucket[1] = bucket[0];
+        bucket[0] = entry;
+    } else {
+        bucket[1] = entry;
+    }
+    t->stores++;
+}
@@ -0,0 +1,108 @@
+/** @file count_table.h
+ *  @brief count table header file.
+ *
+ *  This header contains the prototypes for the counting transposition table module.
+ *  contains the structure definitions of the table and of its entries.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_COUNT_TABLE_H
+#define SUDOKU_COUNT_TABLE_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include "bit_solver.h"
+
+
+/* -- Defines -- */
+#define COUNT_TABLE_DEFAULT_MB 64 /* memory cap of the table when the count_table command wasn't used */
+#define COUNT_TABLE_MIN_LEFT 6 /* smaller subtrees are counted faster than they are hashed */
+
+
+/* -- Structs -- */
+
+/**
+ * @brief countEntry structure representing the solutions count of a residual state kept by the table.
+ * countEntry contains key and check fields, two independent hashes of the state (key 0 and check 0 for an unused entry).
+ * countEntry contains count field, the solutions of the state, and work field, the search nodes it took to count them.
+ *
+ */
+typedef struct countEntry {
+    unsigned long key;
+    unsigned long check;
+    long count;
+    long work;
+} countEntry;
+
+
+/**
+ * @brief countTable structure representing a transposition table of the solution counts of residual states.
+ * a residual state is the set of the cells left empty with the candidates of each, its solutions don't depend on
+ * the path which reached it, so a state reached again isn't searched again.
+ * countTable contains entries field, buckets of two entries: the first keeps the entry which took the most work,
+ * the second the latest one. buckets field contains the amount of buckets, a power of 2.
+ * countTable contains lookups, hits, stores and replacements fields counting the table operations.
+ * countTable contains solutions field, the solutions found by the search using the table so far.
+ * countTable contains levelMemo, levelKey, levelCheck, levelSolutions and levelNodes fields, per search depth:
+ * whether the state the level was opened from is stored when the level ends, its hashes,
+ * and the solutions and nodes counted before it.
+ *
+ */
+typedef struct countTable {
+    countEntry* entries;
+    long buckets;
+    long lookups;
+    long hits;
+    long stores;
+    long replacements;
+    long solutions;
+    bool levelMemo[MAX_BOARD_CELLS];
+    unsigned long levelKey[MAX_BOARD_CELLS];
+    unsigned long levelCheck[MAX_BOARD_CELLS];
+    long levelSolutions[MAX_BOARD_CELLS];
+    long levelNodes[MAX_BOARD_CELLS];
+} countTable;
+
+
+/* -- Global Variables  -- */
+extern __thread long countTableMegabytes; /* memory cap of the table used by num_solutions, 0 disables it */
+
+
+/** @brief Allocates the entries of given table within given memory cap and resets its counters.
+ *  @param t table.
+ *  @param megabytes memory cap, at least 1.
+ *  @return void.
+ */
+void count_table_init(countTable* t, long megabytes);
+
+
+/** @brief Frees the entries of given table.
+ *  @param t table.
+ *  @return void.
+ */
+void count_table_free(countTable* t);
+
+
+/** @brief Looks up the residual state of given search context before it opens the level at its current depth.
+ *  on a hit the found field of the context is set to the stored count, otherwise the state is remembered
+ *  so count_table_close stores it when the level ends.
+ *  @param t table.
+ *  @param s search context.
+ *  @return true if the count of the state was found, else false.
+ */
+bool count_table_probe(countTable* t, bitSolver* s);
+
+
+/** @brief Stores the count of the residual state given level was opened from, when the level ends.
+ *  @param t table.
+ *  @param s search context.
+ *  @param level search depth of the level which ended.
+ *  @return void.
+ */
+void count_table_close(countTable* t, bitSolver* s, int level);
+
+
+#endif /*SUDOKU_COUNT_TABLE_H*/
@@ -0,0 +1,147 @@
+/** @file enumerator.c
+ *  @brief enumerator source file.
+ *
+ *  This module streams every solution of a board to a file, one at a time from the resumable bit solver search.
+ *  The search state is small (the order of the empty cells and the open levels), so it is saved in a checkpoint
+ *  next to the output together with the amount of solutions and bytes written, and an interrupted enumeration
+ *  goes on from the checkpoint: the output is cut back to the checkpointed size and the search resumes.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Defines -- */
+#define _GNU_SOURCE
+
+/* -- Includes -- */
+#include "enumerator.h"
+#include "bit_solver.h"
+#include "main_aux.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+/* Returns true if the path ends with the binary suffix */
+bool binary_path(const char* path) {
+    size_t length = strlen(path), suffix = strlen(ENUMERATE_BINARY_SUFFIX);
+    return length > suffix && strcmp(path + length - suffix, ENUMERATE_BINARY_SUFFIX) == 0;
+}
+
+/* Writes the checkpoint to a temporary file first and renames it, so a crash never leaves half a checkpoint.
+ * the output is flushed first, so everything the checkpoint counts is in the output file */
+bool write_checkpoint(bitSolver* s, FILE* out, const char* checkpointPath, enumerationResult* result) {
+    char tmpPath[ENUMERATE_PATH_SIZE + 4];
+    FILE* fp;
+    long offset;
+    bool ok;
+    if (fflush(out) != 0 || (offset = ftell(out)) < 0) {
+        return false;
+    }
+    sprintf(tmpPath, "%s.tmp", checkpointPath);
+    if ((fp = fopen(tmpPath, "w")) == NULL) {
+        return false;
+    }
+    fprintf(fp, "sudoku-enumeration %d %ld %ld\n", result->binary ? 1 : 0, result->solutions, offset);
+    ok = bit_search_save(s, fp);
+    ok = (fclose(fp) == 0) && ok;
+    return ok && rename(tmpPath, checkpointPath) == 0;
+}
+
+/* Reads the checkpoint header and the search state, and cuts the output back to the checkpointed size.
+ * returns ENUMERATE_DONE when the search is ready to go on */
+int resume_checkpoint(bitSolver* s, FILE* fp, const char* path, enumerationResult* result) {
+    int binary;
+    long offset;
+    if (fscanf(fp, "sudoku-enumeration %d %ld %ld", &binary, &result->solutions, &offset) != 3
+        || binary != (result->binary ? 1 : 0) || result->solutions < 0 || offset < 0 || !bit_search_load(s, fp)) {
+        result->solutions = 0;
+        return ENUMERATE_CHECKPOINT_ERROR;
+    }
+    result->resumed = result->solutions;
+    if (truncate(path, offset) != 0) {
+        bit_search_end(s);
+        return ENUMERATE_FILE_ERROR;
+    }
+    return ENUMERATE_DONE;
+}
+
+/* Writes the current solution of the search context */
+void write_solution(bitSolver* s, FILE* out, bool binary) {
+    char line[MAX_BOARD_CELLS + 2];
+    int idx;
+    if (binary) {
+        for (idx = 0; idx < s->size; idx++) {
+            line[idx] = (char) s->grid[idx];
+        }
+        fwrite(line, 1, s->size, out);
+    } else {
+        bit_format_string(s, line);
+        line[s->size] = '\n';
+        fwrite(line, 1, s->size + 1, out);
+    }
+}
+
+/* Resumes or begins the search, then writes solutions until the search ends, the limit or a stop request */
+int enumerate_solutions(bitSolver* s, const char* path, long limit, enumerationResult* result) {
+    char checkpointPath[ENUMERATE_PATH_SIZE];
+    char* buffer;
+    FILE* fp;
+    FILE* out;
+    int status = SEARCH_FOUND, outcome;
+    result->solutions = 0;
+    result->resumed = 0;
+    result->binary = binary_path(path);
+    sprintf(checkpointPath, "%s%s", path, ENUMERATE_CHECKPOINT_SUFFIX);
+    if ((fp = fopen(checkpointPath, "r")) != NULL) {
+        outcome = resume_checkpoint(s, fp, path, result);
+        fclose(fp);
+        if (outcome != ENUMERATE_DONE) {
+            return outcome;
+        }
+        out = fopen(path, "r+b");
+    } else {
+        bit_search_begin(s);
+        out = fopen(path, "wb");
+    }
+    if (out == NULL) {
+        bit_search_end(s);
+        return ENUMERATE_FILE_ERROR;
+    }
+    buffer = malloc(ENUMERATE_BUFFER_SIZE);
+    if (buffer == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    setvbuf(out, buffer, _IOFBF, ENUMERATE_BUFFER_SIZE);
+    fseek(out, 0, SEEK_END); /* after the solutions kept from the checkpoint */
+    outcome = ENUMERATE_DONE;
+    while (limit == 0 || result->solutions < limit) {
+        if ((status = bit_search_next(s)) != SEARCH_FOUND) {
+            break;
+        }
+        write_solution(s, out, result->binary);
+        result->solutions++;
+        if (result->solutions % ENUMERATE_CHECKPOINT_SOLUTIONS == 0
+            && !write_checkpoint(s, out, checkpointPath, result)) {
+            outcome = ENUMERATE_FILE_ERROR;
+            break;
+        }
+    }
+    if (outcome == ENUMERATE_DONE && status == SEARCH_DONE) {
+        remove(checkpointPath);
+    } else if (outcome == ENUMERATE_DONE) {
+        outcome = (status == SEARCH_STOPPED) ? ENUMERATE_STOPPED : ENUMERATE_LIMIT;
+        if (!write_checkpoint(s, out, checkpointPath, result)) {
+            outcome = ENUMERATE_FILE_ERROR;
+        }
+    }
+    if (fclose(out) != 0) {
+        outcome = ENUMERATE_FILE_ERROR;
+    }
+    free(buffer);
+    bit_search_end(s);
+    return outcome;
+}
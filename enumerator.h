@@ -0,0 +1,64 @@
+/** @file enumerator.h
+ *  @brief enumerator header file.
+ *
+ *  This header contains the prototypes for the solutions enumerator module.
+ *  contains the structure definition of the result of an enumeration.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_ENUMERATOR_H
+#define SUDOKU_ENUMERATOR_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include "bit_solver.h"
+
+
+/* -- Defines -- */
+#define ENUMERATE_BUFFER_SIZE (1 << 20) /* output buffer, solutions are written in large blocks */
+#define ENUMERATE_CHECKPOINT_SOLUTIONS 1000000 /* solutions between checkpoints */
+#define ENUMERATE_CHECKPOINT_SUFFIX ".checkpoint"
+#define ENUMERATE_BINARY_SUFFIX ".bin"
+#define ENUMERATE_PATH_SIZE (MAX_CMD_SIZE + 32)
+
+#define ENUMERATE_DONE 0 /* every solution was written, the checkpoint was removed */
+#define ENUMERATE_LIMIT 1 /* the limit was reached, the checkpoint was kept */
+#define ENUMERATE_STOPPED 2 /* the stop flag was set, the checkpoint was kept */
+#define ENUMERATE_FILE_ERROR (-1) /* the output or the checkpoint could not be written */
+#define ENUMERATE_CHECKPOINT_ERROR (-2) /* the checkpoint is malformed or belongs to another board */
+
+
+/* -- Structs -- */
+
+/**
+ * @brief enumerationResult structure representing the outcome of an enumeration.
+ * enumerationResult contains solutions field, the amount of solutions in the output file (including resumed ones),
+ * and resumed field, the amount which were already there when the enumeration resumed from a checkpoint.
+ * enumerationResult contains binary field, true if the solutions were written in binary.
+ *
+ */
+typedef struct enumerationResult {
+    long solutions;
+    long resumed;
+    bool binary;
+} enumerationResult;
+
+
+/** @brief Writes the solutions of the board in given search context to given file, resuming from the checkpoint of the
+ *  file if it has one. a file ending with ENUMERATE_BINARY_SUFFIX gets one byte per cell value for every solution,
+ *  any other file a line of N * N symbols per solution (as read by --batch-solve).
+ *  a checkpoint, ENUMERATE_CHECKPOINT_SUFFIX added to the file path, is written every ENUMERATE_CHECKPOINT_SOLUTIONS
+ *  solutions and when the enumeration stops before its end, and removed when it ends.
+ *  @param s search context holding the board, not searching, its stop flag stops the enumeration.
+ *  @param path output file path.
+ *  @param limit total amount of solutions to write, 0 for no limit.
+ *  @param result to be updated with the outcome.
+ *  @return ENUMERATE_DONE, ENUMERATE_LIMIT, ENUMERATE_STOPPED, ENUMERATE_FILE_ERROR or ENUMERATE_CHECKPOINT_ERROR.
+ */
+int enumerate_solutions(bitSolver* s, const char* path, long limit, enumerationResult* result);
+
+
+#endif /*SUDOKU_ENUMERATOR_H*/
@@ -0,0 +1,203 @@
+/** @file estimator.c
+ *  @brief estimator source file.
+ *
+ *  This module estimates the number of solutions of boards too sparse to count exactly (an empty 9x9 board has
+ *  about 6.67e21 solutions). A probe follows one random path of the bit solver search tree, and the product of the
+ *  branching factors on the path is an unbiased estimate of the number of solutions (Knuth's estimator).
+ *  The mean of many probes, made by several threads, gives the estimate and its confidence interval.
+ *  The weights are kept in log scale, so boards with more than 1e308 solutions are estimated as well.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "estimator.h"
+#include "bit_solver.h"
+#include "main_aux.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+
+
+/* Resets the estimate sums */
+void estimate_reset(solutionEstimate* e) {
+    e->probes = 0;
+    e->hits = 0;
+    e->shift = 0.0;
+    e->sum = 0.0;
+    e->sumSquares = 0.0;
+    e->logMean = -HUGE_VAL;
+    e->logLow = -HUGE_VAL;
+    e->logHigh = -HUGE_VAL;
+    e->nodes = 0;
+}
+
+/* Rescales the sums of the estimate to a larger shift */
+void estimate_rescale(solutionEstimate* e, double shift) {
+    double factor = exp(e->shift - shift);
+    e->sum *= factor;
+    e->sumSquares *= factor * factor;
+    e->shift = shift;
+}
+
+/* Adds a probe, a dead end adds nothing but the probe itself */
+void estimate_add(solutionEstimate* e, bool found, double logWeight) {
+    double weight;
+    e->probes++;
+    if (!found) {
+        return;
+    }
+    if (e->hits == 0) {
+        e->shift = logWeight;
+    } else if (logWeight > e->shift) {
+        estimate_rescale(e, logWeight);
+    }
+    e->hits++;
+    weight = exp(logWeight - e->shift);
+    e->sum += weight;
+    e->sumSquares += weight * weight;
+}
+
+/* Adds the probes of other, after bringing both to the same shift */
+void estimate_merge(solutionEstimate* e, solutionEstimate* other) {
+    solutionEstimate aligned = *other;
+    if (aligned.hits > 0 && e->hits == 0) {
+        e->shift = aligned.shift;
+    } else if (aligned.hits > 0) {
+        if (aligned.shift > e->shift) {
+            estimate_rescale(e, aligned.shift);
+        } else {
+            estimate_rescale(&aligned, e->shift);
+        }
+    }
+    e->probes += aligned.probes;
+    e->hits += aligned.hits;
+    e->sum += aligned.sum;
+    e->sumSquares += aligned.sumSquares;
+    e->nodes += aligned.nodes;
+}
+
+/* Computes the mean and a normal confidence interval from the sample variance of the probe weights */
+void estimate_finish(solutionEstimate* e) {
+    double n = (double) e->probes, mean, variance, halfWidth;
+    e->logMean = -HUGE_VAL;
+    e->logLow = -HUGE_VAL;
+    e->logHigh = -HUGE_VAL;
+    if (e->hits == 0) {
+        return;
+    }
+    mean = e->sum / n;
+    variance = (n > 1) ? (e->sumSquares / n - mean * mean) * n / (n - 1) : 0.0;
+    if (variance < 0) { /* rounding */
+        variance = 0.0;
+    }
+    halfWidth = ESTIMATE_Z * sqrt(variance / n);
+    e->logMean = (e->shift + log(mean)) / log(10.0);
+    e->logHigh = (e->shift + log(mean + halfWidth)) / log(10.0);
+    if (mean - halfWidth > 0) {
+        e->logLow = (e->shift + log(mean - halfWidth)) / log(10.0);
+    }
+}
+
+/* Writes small numbers in full and others as mantissa and exponent, which works beyond the range of a double */
+void format_log10(double log10Value, char* out) {
+    double exponent, mantissa;
+    if (log10Value == -HUGE_VAL) {
+        sprintf(out, "0");
+        return;
+    }
+    if (log10Value < 6) {
+        sprintf(out, "%.6g", pow(10.0, log10Value));
+        return;
+    }
+    exponent = floor(log10Value);
+    mantissa = pow(10.0, log10Value - exponent);
+    if (mantissa >= 9.995) { /* would be printed as 10 */
+        mantissa /= 10;
+        exponent++;
+    }
+    sprintf(out, "%.3ge%.0f", mantissa, exponent);
+}
+
+/* Estimation worker: claims batches of probes until the budget is used or the estimation is stopped,
+ * then merges its probes into the total */
+void* estimate_worker(void* arg) {
+    estimateRun* run = (estimateRun*) arg;
+    solutionEstimate local;
+    bitSolver* s;
+    long batch, first, probes, i;
+    double logWeight;
+    bool found;
+    s = malloc(sizeof(bitSolver));
+    if (s == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    *s = *run->source; /* the probes leave the grid unchanged, so one copy serves all batches */
+    s->nodes = 0;
+    estimate_reset(&local);
+    while (true) {
+        pthread_mutex_lock(&run->lock);
+        batch = run->nextBatch;
+        first = batch * ESTIMATE_BATCH_PROBES;
+        if ((run->maxProbes > 0 && first >= run->maxProbes) || (run->stop != NULL && *run->stop)
+            || (run->deadline > 0 && get_time_ns() >= run->deadline)) {
+            pthread_mutex_unlock(&run->lock);
+            break;
+        }
+        run->nextBatch++;
+        pthread_mutex_unlock(&run->lock);
+        probes = ESTIMATE_BATCH_PROBES;
+        if (run->maxProbes > 0 && first + probes > run->maxProbes) {
+            probes = run->maxProbes - first;
+        }
+        prng_seed(&s->rng, run->seed + (unsigned long) batch * 0x9E3779B9UL);
+        for (i = 0; i < probes; i++) {
+            found = bit_probe(s, &logWeight);
+            estimate_add(&local, found, logWeight);
+        }
+    }
+    local.nodes = s->nodes;
+    pthread_mutex_lock(&run->lock);
+    estimate_merge(&run->total, &local);
+    pthread_mutex_unlock(&run->lock);
+    free(s);
+    return NULL;
+}
+
+/* Runs the estimation workers, the calling thread runs the first of them */
+void estimate_solutions(bitSolver* s, long maxMs, long maxProbes, int threads, solutionEstimate* result) {
+    estimateRun run;
+    pthread_t* workers;
+    int i;
+    if (threads < 1) {
+        threads = 1;
+    }
+    run.source = s;
+    run.seed = prng_next(&s->rng);
+    run.maxProbes = maxProbes;
+    run.deadline = (maxMs > 0) ? get_time_ns() + maxMs * 1e6 : 0;
+    run.stop = s->stop;
+    run.nextBatch = 0;
+    estimate_reset(&run.total);
+    workers = malloc(threads * sizeof(pthread_t));
+    if (workers == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    pthread_mutex_init(&run.lock, NULL);
+    for (i = 1; i < threads; i++) {
+        pthread_create(&workers[i], NULL, estimate_worker, &run);
+    }
+    estimate_worker(&run);
+    for (i = 1; i < threads; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    pthread_mutex_destroy(&run.lock);
+    free(workers);
+    estimate_finish(&run.total);
+    *result = run.total;
+}
@@ -0,0 +1,128 @@
+/** @file estimator.h
+ *  @brief estimator header file.
+ *
+ *  This header contains the prototypes for the solutions estimator module.
+ *  contains the structure definitions of an estimate and of the state shared by the estimating threads.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_ESTIMATOR_H
+#define SUDOKU_ESTIMATOR_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include "bit_solver.h"
+#include <pthread.h>
+
+
+/* -- Defines -- */
+#define ESTIMATE_DEFAULT_MS 1000 /* time budget when neither a time nor a probes budget is given */
+#define ESTIMATE_BATCH_PROBES 256 /* probes claimed at once, between checks of the clock and the stop flag */
+#define ESTIMATE_Z 1.96 /* normal quantile of the 95% confidence interval */
+#define ESTIMATE_FORMAT_SIZE 32 /* buffer size of a formatted estimate */
+
+
+/* -- Structs -- */
+
+/**
+ * @brief solutionEstimate structure representing the sums of a set of probes, and the estimate they give.
+ * probe weights can pass the range of a double (a 25x25 board has far more than 1e308 solutions),
+ * so the sums are kept relative to shift: the natural log of the largest weight seen.
+ * solutionEstimate contains probes field, the amount of probes, and hits field, the amount which reached a solution.
+ * solutionEstimate contains shift field and sum and sumSquares fields, the sums of weight / e^shift and of its square.
+ * solutionEstimate contains logMean, logLow and logHigh fields, the log10 of the estimate and of the bounds of its
+ * confidence interval, set by estimate_finish (logLow is -HUGE_VAL when the interval reaches 0).
+ * solutionEstimate contains nodes field counting the search nodes visited.
+ *
+ */
+typedef struct solutionEstimate {
+    long probes;
+    long hits;
+    double shift;
+    double sum;
+    double sumSquares;
+    double logMean;
+    double logLow;
+    double logHigh;
+    long nodes;
+} solutionEstimate;
+
+
+/**
+ * @brief estimateRun structure representing the state shared by the threads of an estimation.
+ * estimateRun contains source field, the search context holding the board, and seed field, batch k of probes is
+ * seeded with seed and k so a probes budget makes the same probes whatever the amount of threads.
+ * estimateRun contains maxProbes field (0 for no limit), deadline field (0 for none) and stop field,
+ * a flag which stops the estimation when set by another thread (NULL for none).
+ * estimateRun contains nextBatch field containing the next batch to claim and total field, the merged probes.
+ * estimateRun contains lock field protecting nextBatch and total.
+ *
+ */
+typedef struct estimateRun {
+    bitSolver* source;
+    unsigned long seed;
+    long maxProbes;
+    double deadline;
+    volatile bool* stop;
+    long nextBatch;
+    solutionEstimate total;
+    pthread_mutex_t lock;
+} estimateRun;
+
+
+/** @brief Resets given estimate to hold no probes.
+ *  @param e estimate.
+ *  @return void.
+ */
+void estimate_reset(solutionEstimate* e);
+
+
+/** @brief Adds a probe to given estimate.
+ *  @param e estimate.
+ *  @param found true if the probe reached a solution.
+ *  @param logWeight natural log of the probe weight, ignored when found is false.
+ *  @return void.
+ */
+void estimate_add(solutionEstimate* e, bool found, double logWeight);
+
+
+/** @brief Adds the probes of an estimate to another.
+ *  @param e estimate to be updated.
+ *  @param other estimate to add, remains unchanged.
+ *  @return void.
+ */
+void estimate_merge(solutionEstimate* e, solutionEstimate* other);
+
+
+/** @brief Computes the estimate and the bounds of its 95% confidence interval from the sums of given estimate.
+ *  @param e estimate with at least one probe.
+ *  @return void.
+ */
+void estimate_finish(solutionEstimate* e);
+
+
+/** @brief Writes a number given by its log10 in scientific notation, such as 6.67e21, or 0.
+ *  @param log10Value log10 of the number, -HUGE_VAL for 0.
+ *  @param out buffer of ESTIMATE_FORMAT_SIZE chars.
+ *  @return void.
+ */
+void format_log10(double log10Value, char* out);
+
+
+/** @brief Estimates the number of solutions of the board in given search context by random probes of its search tree,
+ *  using threads threads until maxProbes probes were made, maxMs milliseconds passed or the stop flag of the
+ *  context is set. the grid remains unchanged, and the context generator is advanced once.
+ *  @param s search context holding the board, not searching.
+ *  @param maxMs time budget in milliseconds, 0 for no limit.
+ *  @param maxProbes probes budget, 0 for no limit (one of the budgets or the stop flag must be set).
+ *  @param threads amount of threads, the calling thread is one of them.
+ *  @param result to be updated with the finished estimate.
+ *  @return void.
+ */
+void estimate_solutions(bitSolver* s, long maxMs, long maxProbes, int threads, solutionEstimate* result);
+
+
+#endif /*SUDOKU_ESTIMATOR_H*/
@@ -1,838 +1,1446 @@
-/** @file game.c
- *  @brief game source file.
- *
- *  This module encapsulates the sudoku puzzle game and the Sudoku board.
- *  Includes functions to match all game commands to be entered by the user.
- *  Includes auxiliary functions that are relevant specifically to the game board state or the game mode.
- *
- *  @author Itay Keren (itaykeren)
- *  @author Rotem Bar (rotembar)
- *
- */
-
-/* -- Defines -- */
-#define _GNU_SOURCE
-
-/* -- Includes -- */
-#include "game.h"
-#include "main_aux.h"
-#include "solver.h"
-#include "linked_list.h"
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-
-
-/* -- Global Variables  -- */
-extern int blockRows;
-extern int blockCols;
-extern int markErrors;
-extern char mode;
-extern bool gameOver;
-
-/* returns the amount of empty (UNASSIGNED) cells in given sudoku board */
-int count_empty_cells(cell** board) {
-    int i, j;
-    int counter = 0;
-    int N = blockRows * blockCols;
-    for (i = 0; i < N; i++) {
-        for (j = 0; j < N; j++) {
-            if (board[i][j].number == UNASSIGNED) {
-                counter++;
-            }
-        }
-    }
-    return counter;
-}
-
-/* empty sudoku board by assigning all cells values to UNASSIGNED and by removing fixation or asterisks */
-void empty_board(cell** board) {
-    int i, j;
-    int N = blockRows * blockCols;
-    for (i = 0; i < N; i++) {
-        for (j = 0; j < N; j++) {
-            board[i][j].number = UNASSIGNED;
-            board[i][j].asterisk = false;
-            board[i][j].isFixed = false;
-        }
-    }
-}
-
-/* returns true if all sudoku board cells are empty (UNASSIGNED), else returns false */
-bool board_is_empty(cell** board) {
-    int N = blockRows * blockCols;
-    if (count_empty_cells(board) != N * N){
-        return false;
-    }
-    return true;
-}
-
-/* returns a new sudoku board, generated by allocating memory and emptying the board */
-cell** generate_empty_board(){
-    int i, N;
-    cell** board = NULL;
-    N =  blockRows * blockCols;
-    board = calloc(N, sizeof (*board));
-    if (board == NULL) {
-        memory_error("Memory allocation failed\n");
-        exit(0);
-    }
-    for (i = 0; i < N; i++) {
-        board[i] = NULL;
-        board[i] = calloc(N, sizeof (**board));
-        if (board[i] == NULL) {
-            memory_error("Memory allocation failed\n");
-            exit(0);
-        }
-    }
-    empty_board(board);
-    return board;
-}
-
-/* copies a source sudoku board to a new identical sudoku board */
-void copy_board(cell** source_board, cell** new_board){
-    int i, j;
-    int N = blockRows * blockCols;
-    for (i  =0; i < N; i++) {
-        for (j = 0; j < N; j++){
-            new_board[i][j].number = source_board[i][j].number;
-            new_board[i][j].asterisk = source_board[i][j].asterisk;
-            new_board[i][j].isFixed = source_board[i][j].isFixed;
-        }
-    }
-}
-
-/* returns true if given value is in the sudoku board's block corresponding to the row and column given,
- * else returns false.
- * if encounters within the block in a cell containing the given value, it marks it with an asterisk */
-bool val_in_block(cell** board, int column, int row, int val){
-    bool valExist = false;
-    int initialCol, initialRow, colIndex, rowIndex;
-    initialCol = get_block_col_index(column);
-    initialRow = get_block_row_index(row);
-    for (colIndex = initialCol; (colIndex < blockCols + initialCol); colIndex++) {
-        for (rowIndex = initialRow; (rowIndex < blockRows + initialRow); rowIndex++) {
-            if ((colIndex == column - 1) && (rowIndex == row - 1)) { /* skips check for the cell about to change */ }
-            else if (board[rowIndex][colIndex].number == val) {
-                valExist = true;
-                if (board[rowIndex][colIndex].isFixed == false && board[rowIndex][colIndex].number != UNASSIGNED) { /* only marking unfixed cells */
-                    board[rowIndex][colIndex].asterisk = true;
-                }
-            }
-        }
-    }
-    return valExist;
-}
-
-/* returns true if given value is in the sudoku board's given row,
- * else returns false.
- * if encounters within the row in a cell containing the given value, it marks it with an asterisk */
-bool val_in_row(cell** board, int column, int row, int val){
-    int N = blockRows * blockCols;
-    bool valExist = false;
-    int colIndex;
-    for (colIndex = 0; colIndex < N; colIndex++) {
-        if(colIndex == column - 1) {/* not checking cell to be changed*/}
-        else if (board[row - 1][colIndex].number == val) {
-            valExist = true;
-            if (board[row - 1][colIndex].isFixed == false && board[row - 1][colIndex].number != UNASSIGNED) { /* only marking unfixed cells */
-                board[row - 1][colIndex].asterisk = true;
-            }
-        }
-    }
-    return valExist;
-}
-
-/* returns true if given value is in the sudoku board's given column,
- * else returns false.
- * if encounters within the column in a cell containing the given value, it marks it with an asterisk */
-bool val_in_column(cell** board, int column, int row, int val) {
-    /*
-     * Checks if value exist in the given column
-     */
-    int N = blockRows * blockCols;
-    bool valExist = false;
-    int rowIndex;
-    for (rowIndex = 0; rowIndex < N; rowIndex++) {
-        if(rowIndex == row - 1){/*not checking cell to be changed*/}
-        else if (board[rowIndex][column - 1].number == val) {
-            valExist = true;
-            if (board[rowIndex][column - 1].isFixed == false && board[rowIndex][column - 1].number != UNASSIGNED) { /* only marking unfixed cells */
-                board[rowIndex][column - 1].asterisk = true;
-            }
-        }
-    }
-    return valExist;
-}
-
-/* returns true if given value is valid in the cell corresponding to the row and column given in the sudoku board,
- * else returns false.
- * the valid check is done according to the game rules - checking row, column and block.
- * if value is invalid it marks it with an asterisk */
-bool valid_check(cell** board, int column, int row, int val) {
-    if(val_in_block(board, column, row, val) | val_in_row(board, column, row, val) | val_in_column(board, column, row, val)){
-        if (val != UNASSIGNED) {
-            board[row - 1][column - 1].asterisk = true;
-            return false;
-        }
-        else{
-            board[row - 1][column - 1].asterisk = false;
-            return true;
-        }
-    }
-    else{
-        board[row - 1][column - 1].asterisk = false;
-        return true;
-    }
-
-}
-
-
-/* marks all cells in the sudoku board that contains invalid values according to game rules with an asterisk */
-void mark_asterisks(cell** board) {
-    int i, j;
-    int N = blockCols * blockRows;
-    for (i = 0; i < N; i++) {
-        for (j = 0; j < N; j++) {
-            if (board[i][j].number != UNASSIGNED) {
-                valid_check(board, j + 1, i + 1, board[i][j].number);
-            }
-        }
-    }
-}
-
-/* updates moves list by adding a copy of given sudoku board(after a game move was done) to the end of the list */
-void update_moves_list(cell** board, list* lst) {
-    cell** boardAfter;
-    boardAfter = generate_empty_board();
-    copy_board(board, boardAfter);
-    insert_at_tail(boardAfter, lst);
-    return;
-}
-
-/* helper function to print_board() which prints block separators */
-void print_separator(int N, int m) {
-    char dash = '-';
-    int i;
-    int count = 4 * N + m + 1;
-    for (i = 0; i < count; i++) {
-        putchar(dash);
-    }
-    putchar('\n');
-}
-
-/* prints the given sudoku board according to the format, game mode and markErrors value */
-void print_board(cell** board, char mode) {
-    int i, j;
-    int N = blockRows * blockCols;
-    for (i = 0; i < N; i++) {
-        if (i % blockRows == 0){
-            print_separator(N, blockRows);
-        }
-        for (j = 0; j < N; j++) {
-            if (j % blockCols == 0) {
-                printf("|");
-            }
-            printf(" ");
-            if (board[i][j].isFixed) {
-                printf("%2d", board[i][j].number);
-                printf(".");
-            }
-            else if ((board[i][j].asterisk) && (markErrors || mode == 'E')) { /* always marking errors in 'E' mode */
-                printf("%2d", board[i][j].number);
-                printf("*");
-            }
-            else if (board[i][j].number != UNASSIGNED){
-                printf("%2d ", board[i][j].number);
-            }
-            else{ /* printing blank spaces for UNASSIGNED */
-                printf("   ");
-            }
-        }
-        printf("|\n");
-    }
-    print_separator(N, blockRows);
-}
-
-/* returns true if given sudoku board contains erroneous cells (marked with an asterisk),
- * else returns false */
-bool check_board_erroneous(cell **board){
-    int colIndex, rowIndex = 0;
-    int N = blockRows * blockCols;
-    for (rowIndex = 0; rowIndex < N; rowIndex++) {
-        for (colIndex = 0; colIndex < N; colIndex++) {
-            if (board[rowIndex][colIndex].asterisk) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-/* validates the given sudoku board using ILP and prints an appropriate message */
-void validate(cell** board) {
-    cell** copyBoard;
-    int solvable;
-    if (check_board_erroneous(board)) {
-        printf(ERRONEOUS_ERROR );
-        return;
-    }
-    copyBoard = duplicate_board(board);
-    solvable = ILP(board, copyBoard);
-    if (solvable == true) {
-        printf("Validation passed: board is solvable\n");
-    } else {
-        printf("Validation failed: board is unsolvable\n");
-    }
-    free_board(copyBoard);
-}
-
-/* helper function to num_solutions that returns the number of solutions of the given sudoku board,
- * using exhaustive deterministic backtrack  */
-int count_solutions(cell** board) {
-    int numOfSolutions;
-    int* unassignedsArray;
-    cell** boardCopy = generate_empty_board();
-    copy_board(board, boardCopy);
-    unassignedsArray = get_next_play(boardCopy);
-    if (unassignedsArray[0] == -1) {
-        free(unassignedsArray);
-        return 0;
-    }
-    numOfSolutions = deterministic_backtrack(boardCopy, unassignedsArray[0], unassignedsArray[1]);
-    free_board(boardCopy);
-    free(unassignedsArray);
-    return numOfSolutions;
-}
-
-/* counts the number of solutions of the given sudoku board and prints it with an appropriate message */
-void num_solutions(cell** board) {
-    int solutionsCounter;
-    if (check_board_erroneous(board)) {
-        printf(ERRONEOUS_ERROR);
-    }
-    solutionsCounter = count_solutions(board);
-    printf("Number of solutions: %d\n", solutionsCounter);
-    if (solutionsCounter == 1) {
-        printf("This is a good board!\n");
-    } else if (solutionsCounter > 1) {
-        printf("The puzzle has more than 1 solution, try to edit it further\n");
-    }
-}
-
-/* saves the given sudoku board to the given file path */
-void save_command(cell** board, char* filePath) {
-    FILE* fp;
-    int i, j, N;
-    cell** copyOfBoard;
-    bool solvable;
-    if (mode == 'E') {
-        if (check_board_erroneous(board)) { /* board to be saved in 'E' mode must'nt contain errors */
-            printf(ERRONEOUS_ERROR);
-            return;
-        }
-        copyOfBoard = generate_empty_board();
-        solvable = ILP(board,copyOfBoard);
-        free_board(copyOfBoard);
-        if (!solvable) { /* board to be saved in 'E' mode must be solvable */
-            printf("Error: board validation failed\n");
-            return;
-        }
-    }
-    if ((fp = fopen(filePath, "wb")) == NULL) { /* file does not exist or can't be open */
-        printf("Error: File cannot be created or modified\n");
-    }
-    if (fprintf(fp, "%d %d\n", blockRows, blockCols) < 1){ /* failed to write */
-        printf("Writing to file failed. Game not saved\n");
-        return;
-    }
-    N = blockRows * blockCols;
-    for (i = 0; i < N; i++) {
-        for (j = 0; j < N; j++) {
-            fprintf(fp, "%d", board[i][j].number);
-            if ((board[i][j].isFixed || mode == 'E') && (board[i][j].number != UNASSIGNED)) {
-                fprintf(fp, ".");
-            }
-            fprintf(fp, " ");
-        }
-        fprintf(fp, "\n");
-    }
-    fclose(fp);
-    printf("Saved to: %s\n", filePath);
-}
-
-/* sets global variable markErrors with legal given value  */
-void mark_errors_command(int value) {
-    if (value == 0) {
-        markErrors = 0;
-    } else if (value == 1) {
-        markErrors = 1;
-    }
-    else {
-        printf(MARK_ERROR_ERROR);
-    }
-}
-
-/* loads a sudoku board from given file path */
-cell** load_board(FILE* fp, char mode){
-    int i, j, N;
-    cell** board = NULL;
-    char line[257];
-    char* token;
-    char* delimiter = " \t\r\n";
-    if (fgets(line, 257, fp) != NULL) {
-        token = strtok(line, delimiter);
-        blockRows = atoi(token);
-        token = strtok(NULL, delimiter);
-        blockCols = atoi(token);
-    } else {
-        printf("Error: File read failed\n");
-        return NULL;
-    }
-    board = generate_empty_board();
-    N = blockRows * blockCols;
-    for (i = 0; i < N; i++) {
-        fgets(line, 256, fp);
-        token = strtok(line, delimiter);
-        for (j = 0; j < N; j++) {
-            board[i][j].number = token[0] - '0';
-            if ((token[1] == '.') && (mode == 'S')) {  /* cells are marked as fixes only in 'S' mode */
-                board[i][j].isFixed = true;
-            }
-            else if (token[1] == '*') {
-                board[i][j].asterisk = true;
-            }
-            token = strtok(NULL, delimiter);
-        }
-    }
-    mark_asterisks(board);
-    return board;
-}
-
-/* returns a sudoku board to be edited:
- * loading an existing sudoku board from given file path or generating a new 9X9 board.
- * if succeeded prints the board, else prints an appropriate error message */
-cell** edit_command(char* parsedCommand[4], char mode){
-    cell** board = NULL;
-    FILE* fp = NULL;
-    if (parsedCommand[1] != '\0'){
-        fp = fopen(parsedCommand[1], "r");
-        if (fp != NULL) {
-            board = load_board(fp, mode);
-            fclose(fp);
-        }
-        else {
-            printf("Error: File cannot be opened\n");
-            return board;
-        }
-    } else {
-        blockRows = 3;
-        blockCols = 3;
-        board = generate_empty_board();
-    }
-    print_board(board, mode);
-    return board;
-}
-
-/* returns a sudoku board to be solved:
- * loading an existing sudoku board from given file path.
- * if succeeded prints the board, else prints an appropriate error message */
-cell** solve_command(char* parsedCommand[4], char mode){
-    cell** board = NULL;
-    FILE* fp = NULL;
-    if (parsedCommand[1] == '\0'){
-        printf(INVALID_ERROR);
-        return board;
-    }
-    fp = fopen(parsedCommand[1], "r");
-    if (fp != NULL) {
-        board = load_board(fp, mode);
-        fclose(fp);
-        print_board(board, mode);
-    } else {
-        printf("Error: File doesn't exist or cannot be opened\n");
-    }
-    return board;
-}
-
-
-/* checks if given sudoku board is completely full and solved successfully according to the game rules,
- * using ILP for validation.
- * if solved - prints appropriate message, updating game mode to 'I' and gameOver flag to true.
- * if full and solved incorrectly prints appropriate message and not changing game mode or gameOver flag. */
-void game_over(cell** board){
-    int col, row;
-    bool solvable;
-    bool full = true;
-    cell** copyBoard;
-    int N = blockCols * blockRows;
-    for (col = 0; col < N; col++) {
-        for (row = 0; row < N; row++) {
-            if (board[row][col].number == UNASSIGNED) {
-                full = false;
-            }
-        }
-    }
-    if (full) {
-        copyBoard = generate_empty_board();
-        solvable = ILP(board, copyBoard);
-        free_board(copyBoard);
-        if (solvable) {
-            printf(GAME_OVER);
-            mode = 'I';
-            gameOver = true;
-        } else {
-            printf("Puzzle solution erroneous\n");
-        }
-    }
-}
-
-/* helper function which validates asterisks after a new set of value in the given indexes was made.
- * returns true if at least one cell was found to be invalid, else return false.
- * if previously asterisk cell is now valid it updates asterisk to false
- * if new risks are found, it marks them with an asterisk */
-bool validate_risks(cell** board, int column, int row) {
-    int initialCol, initialRow, colIndex, rowIndex;
-    int N = blockRows * blockCols;
-    bool risksFound = true;
-    initialCol = get_block_col_index(column);
-    initialRow = get_block_row_index(row);
-    for (colIndex = initialCol; (colIndex < blockCols + initialCol); colIndex++) { /* block check */
-        for (rowIndex = initialRow; (rowIndex < blockRows + initialRow); rowIndex++) {
-            if (colIndex == (column - 1) && rowIndex == (row - 1)) { /* not checking cell changed */
-            }
-            else if (board[rowIndex][colIndex].asterisk){
-                if(valid_check(board, colIndex + 1, rowIndex + 1, board[rowIndex][colIndex].number)){
-                    board[rowIndex][colIndex].asterisk = false;
-                }
-                else{
-                    risksFound = false;
-                }
-            }
-        }
-    }
-    for (colIndex = 0; (colIndex < N); colIndex++) { /* row check */
-        if (colIndex == column - 1) {
-        }
-        else if (board[row - 1][colIndex].asterisk){
-            if (valid_check(board, colIndex + 1, row, board[row - 1][colIndex].number)){
-                board[row - 1][colIndex].asterisk = false;
-            }
-            else{
-                risksFound = false;
-            }
-        }
-    }
-
-    for (rowIndex = 0; (rowIndex < N); rowIndex++) {  /* col check */
-        if (rowIndex == row - 1){
-        }
-        else if (board[rowIndex][column - 1].asterisk){
-            if( valid_check(board, column , rowIndex + 1, board[rowIndex][column - 1].number)){
-                board[rowIndex][column - 1].asterisk = false;
-            }
-            else{
-                risksFound = false;
-            }
-        }
-    }
-    return risksFound;
-}
-
-/* fills cells in given sudoku board which can contain a single legal value.
- * returns true if at least one cell was filled, else returns false */
-bool auto_fill(cell** board)    {
-    int i, j, k, candidate;
-    int fillFlag = false;
-    int numOfCandidates = 0;
-    int maxValue = blockRows * blockCols + 1;
-    cell** copyOfBoard;
-    int N = blockRows * blockCols;
-    if (check_board_erroneous(board)){
-        printf(ERRONEOUS_ERROR);
-        return false;
-    }
-    copyOfBoard = generate_empty_board();
-    copy_board(board, copyOfBoard);
-    for (i = 0; i < N; i++){
-        for (j = 0; j < N; j++){
-            if (copyOfBoard[i][j].number == UNASSIGNED){
-                for (k = 1; k < maxValue; k++){
-                    if (valid_check(copyOfBoard, j + 1, i + 1, k)){
-                        candidate = k;
-                        numOfCandidates++;
-                    }
-                }
-                if (numOfCandidates == 1){
-                    board[i][j].number = candidate;
-                    validate_risks(board, j + 1, i + 1);
-                    fillFlag = true;
-                    printf("Cell <%d,%d> set to %d\n", (j+1), (i+1), candidate);
-                }
-                numOfCandidates = 0;
-            }
-        }
-    }
-    free_board(copyOfBoard);
-    print_board(board, mode);
-    game_over(board);
-    return fillFlag;
-}
-
-/* sets given value to corresponding cell(according to indexes given) in given sudoku board.
- * if either value or indexes are invalid or cell is fixed prints appropriate error message.
- * validating asterisks to update marking of asterisks cells if needed.
- * checks if game is over after the set was made.
- * returns true if s set which changed the board status was made, else return false.
- * prints the board if set was successful */
-bool set(cell** board, int column, int row, int val, char mode) {
-    int N = blockRows * blockCols;
-    if((!valid_board_index(column, N)) || (!valid_board_index(row, N)) || (!valid_set_value(val, N))){
-        printf(VALUE_RANGE_ERROR, blockCols * blockRows);
-        return false;
-    }
-    if (board[row - 1][column - 1].isFixed) {
-        printf(FIXED_ERROR);
-        return false;
-    }
-    else if (board[row - 1][column - 1].number == val) {
-        print_board(board, mode);
-        return  false;
-    }
-    else if (val == 0) {
-        board[row - 1][column - 1].number = UNASSIGNED;
-        board[row - 1][column - 1].asterisk = false;
-        validate_risks(board, column, row);
-        print_board(board, mode);
-        return true;
-    }
-    else {
-        valid_check(board, column, row, val);
-        board[row - 1][column - 1].number = val;
-        validate_risks(board, column, row);
-        print_board(board, mode);
-        if (mode == 'S'){
-            game_over(board);
-        }
-        return true;
-    }
-}
-
-/* prints a valid hint value of the corresponding cell(according to indexes given) in the given sudoku board.
- * hint value is taken from solving the board given using ILP.
- * if either indexes are invalid, board contains errors, cell is fixed or full prints appropriate error message.
- * if board is unsolvable prints appropriate error message.
- */
-void hint(cell** board, int column, int row){
-    int hint;
-    bool solvable;
-    cell** solvedBoard = NULL;
-    int N = blockCols * blockRows;
-    if((!valid_board_index(column, N)) || (!valid_board_index(row, N))) {
-        printf("Error: value not in range 1-%d\n",N);
-        return;
-    }
-    if (check_board_erroneous(board)) {
-        printf(ERRONEOUS_ERROR);
-        return;
-    }
-    if (board[row - 1][column - 1].isFixed) {
-        printf(FIXED_ERROR);
-        return;
-    }
-    if (board[row - 1][column - 1].number != 0) {
-        printf("Error: cell already contains a value\n");
-        return;
-    }
-    solvedBoard = generate_empty_board();
-    solvable = ILP(board, solvedBoard);
-    if (solvable == false){
-        printf("Error: board is unsolvable\n");
-        free_board(solvedBoard);
-        return;
-    }
-    else{
-        hint = solvedBoard[row - 1][column - 1].number;
-        printf("Hint: set cell to %d\n", hint);
-        free_board(solvedBoard);
-    }
-}
-
-/* frees allocated memory of given sudoku board */
-void free_board(cell** board){
-    int i;
-    int N = blockRows * blockCols;
-    for (i = 0; i < N; i++) {
-        free(board[i]);
-    }
-    free(board);
-    board = NULL;
-
-}
-/* frees allocated memory for given command, exists the game after printing appropriate message */
-void exit_game(char* command){
-    printf("Exiting...\n");
-    free(command);
-    exit(0);
-}
-
-/* fills the corresponding cell(according to indexes given) in the given sudoku board with a random legal value,
- * if no value found returns false, else returns true */
-bool fill_cell(cell** board, int column, int row){
-    cell** copyOfBoard;
-    int numbersLeft, randomIndex, nextNum;
-    int N = blockRows * blockCols;
-    int* availableNumbers;
-    availableNumbers = generate_int_array(N); /* int pointer containing available numbers to be filled from 1-N */
-    copyOfBoard = generate_empty_board();
-    copy_board(board, copyOfBoard);
-    numbersLeft = N;
-    while (numbersLeft > 0){
-        randomIndex = rand() % numbersLeft;
-        nextNum = availableNumbers[randomIndex];
-        if(valid_check(copyOfBoard, column + 1 ,row + 1, nextNum)){
-            copyOfBoard[row][column].number = nextNum;
-            copy_board(copyOfBoard, board); /* updating original board */
-            free_board(copyOfBoard);
-            free(availableNumbers);
-            return true;
-        }
-        copyOfBoard[row][column].number = UNASSIGNED;
-        copyOfBoard[row][column].asterisk = false;
-        numbersLeft--;
-        if (numbersLeft > 0) {
-            delFromArr(randomIndex, numbersLeft, availableNumbers); /* updating available numbers by deleting illegals*/
-        }
-    }
-    free_board(copyOfBoard); /* no legal value was found */
-    free(availableNumbers);
-    return false;
-}
-
-/* generates a random sudoku board by filling the empty board given:
- * first step: filling board with amount of initialFullCells of random legal values
- * if first step is successful - second step: validating board to using ILP to see if solvable
- * if second step is successful - third step :  copying valid amont of random copyCells to the given board.
- * when either step one or two fails board is emptying and process starts again from first step
- * after 1000 failed attempts an appropriate error message is printed and function returns false
- * if generation is successful the given board is updated and function return true and prints the board */
-bool generate_randomized_solved_board (cell** board, int initialFullCells, int copyCells) {
-    cell **newBoard;
-    bool solvable;
-    int randCol, randRow, emptyCellsCounter;
-    int cellsFilled = 0;
-    int triesLeft = 1000;
-    int N = blockCols * blockRows;
-    emptyCellsCounter = count_empty_cells(board);
-    if ((!valid_set_value(initialFullCells, emptyCellsCounter)) || (!valid_set_value(copyCells, emptyCellsCounter))) {
-        printf(VALUE_RANGE_ERROR, emptyCellsCounter);
-        return false;
-    }
-    if (!board_is_empty(board)) {
-        printf("Error: board is not empty\n");
-        return false;
-    }
-    while (triesLeft > 0) {
-        if (cellsFilled < initialFullCells) {
-            randCol = rand() % N;
-            randRow = rand() % N;
-            if (board[randRow][randCol].number == UNASSIGNED) {
-                if (!fill_cell(board, randCol, randRow)) { /* failed to find legal value to cell chosen */
-                    triesLeft--;
-                    empty_board(board);
-                    cellsFilled = 0;
-                } else {
-                    cellsFilled++;
-                }
-            }
-        }
-        else if (cellsFilled == initialFullCells) {
-            newBoard = generate_empty_board();
-            solvable = ILP(board, newBoard);
-            empty_board(board);
-            if (solvable) {
-                copy_random_cells(newBoard, copyCells, board);
-                free_board(newBoard);
-                print_board(board, mode);
-                if (board_is_empty(board)){
-                    return false;
-                }
-                return true;
-            } else { /* failed to solve board */
-                triesLeft--;
-                empty_board(board);
-                free_board(newBoard);
-                cellsFilled = 0;
-            }
-        }
-    }
-    printf("Error: puzzle generator failed\n");
-    return false;
-}
-
-/* evaluates the user-entered game command and calls the relevant function to execute it.
- * performs preliminary input checks before calling the relevant function,
- * prints an appropriate error message when necessary.
- * updates the moves list in each step that changed the status of the given sudoku board */
-void execute_command(char* parsedCommand[4], cell** board, char* command, int counter, char mode, list* lst){
-    bool cmdExecuted = false;
-    int N = blockRows *blockCols;
-    if (strcmp(parsedCommand[0], "set") == 0 && counter == 4 && (mode == 'E' || mode == 'S')) {
-        if ((!is_integer(parsedCommand[1])) || (!is_integer(parsedCommand[2])) || (!is_integer(parsedCommand[3]))){
-            printf(VALUE_RANGE_ERROR, N);
-            return;
-        }
-        cmdExecuted = set(board, atoi(parsedCommand[1]), atoi(parsedCommand[2]), atoi(parsedCommand[3]), mode);
-        if (cmdExecuted) {
-            update_moves_list(board, lst);
-        }
-    } else if (strcmp(parsedCommand[0], "hint") == 0 && counter >= 3 && mode == 'S') {
-        if ((!is_integer(parsedCommand[1])) || (!is_integer(parsedCommand[2]))){
-            printf("Error: value not in range 1-%d\n",N);
-            return;
-        }
-        hint(board, atoi(parsedCommand[1]), atoi(parsedCommand[2]));
-    } else if (strcmp(parsedCommand[0], "validate") == 0  && (mode == 'E' || mode == 'S')) {
-        validate(board);
-    } else if ((strcmp(parsedCommand[0], "print_board") == 0) && (mode == 'E' || mode == 'S')) {
-        print_board(board, mode);
-    } else if (strcmp(parsedCommand[0], "mark_errors") == 0 && counter >= 2 && (mode == 'S')) {
-        if (!is_integer(parsedCommand[1])) {
-            printf(MARK_ERROR_ERROR);
-            return;
-        }
-        mark_errors_command(atoi(parsedCommand[1]));
-    } else if (strcmp(parsedCommand[0], "autofill") == 0 && mode == 'S') {
-        cmdExecuted = auto_fill(board);
-        if (cmdExecuted) {
-            update_moves_list(board, lst);
-        }
-    } else if (strcmp(parsedCommand[0], "save") == 0 && counter >= 2 && (mode == 'E' || mode == 'S')) {
-        save_command(board, parsedCommand[1]);
-    } else if (strcmp(parsedCommand[0], "num_solutions") == 0 && (mode == 'E' || mode == 'S')) {
-        num_solutions(board);
-    } else if (strcmp(parsedCommand[0], "generate") == 0 && counter >= 3 && mode == 'E' ) {
-        if ((!is_integer(parsedCommand[1])) || (!is_integer(parsedCommand[2]))){
-            printf(VALUE_RANGE_ERROR, count_empty_cells(board));
-            return;
-        }
-        cmdExecuted = generate_randomized_solved_board(board, atoi(parsedCommand[1]), atoi(parsedCommand[2]));
-        if (cmdExecuted) {
-            update_moves_list(board, lst);
-        }
-    } else if (((strcmp(parsedCommand[0], "undo") == 0)) && (mode == 'E' || mode == 'S')) {
-        undo(lst, board, mode);
-    } else if (((strcmp(parsedCommand[0], "redo") == 0)) && (mode == 'E' || mode == 'S')) {
-        redo(lst, board, mode);
-    } else if (((strcmp(parsedCommand[0], "reset") == 0)) && (mode == 'E' || mode == 'S')) {
-        reset(lst, board, mode);
-    } else if (strcmp(parsedCommand[0], "exit") == 0) {
-        if (mode != 'I' || gameOver) {
-            free_board(board);
-            free_list(lst);
-        }
-        exit_game(command);
-    } else {
-        printf(INVALID_ERROR);
-    }
-}
+/** @file game.c
+ *  @brief game source file.
+ *
+ *  This module encapsulates the sudoku puzzle game and the Sudoku board.
+ *  Includes functions to match all game commands to be entered by the user.
+ *  Includes auxiliary functions that are relevant specifically to the game board state or the game mode.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Defines -- */
+#define _GNU_SOURCE
+
+/* -- Includes -- */
+#include "game.h"
+#include "main_aux.h"
+#include "solver.h"
+#include "linked_list.h"
+#include "render.h"
+#include "bit_solver.h"
+#include "generator.h"
+#include "grader.h"
+#include "cache.h"
+#include "background.h"
+#include "job.h"
+#include "estimator.h"
+#include "count_table.h"
+#include "enumerator.h"
+#include "shard.h"
+#include "stats.h"
+#include "board_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+
+/* -- Global Variables  -- */
+extern __thread int blockRows;
+extern __thread int blockCols;
+extern __thread int markErrors;
+extern __thread char mode;
+extern __thread bool gameOver;
+extern bool quietMode;
+
+/* returns the amount of empty (UNASSIGNED) cells in given sudoku board */
+int count_empty_cells(cell** board) {
+    int i, j;
+    int counter = 0;
+    int N = blockRows * blockCols;
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            if (board[i][j].number == UNASSIGNED) {
+                counter++;
+            }
+        }
+    }
+    return counter;
+}
+
+/* empty sudoku board by assigning all cells values to UNASSIGNED and by removing fixation or asterisks */
+void empty_board(cell** board) {
+    int i, j;
+    int N = blockRows * blockCols;
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            board[i][j].number = UNASSIGNED;
+            board[i][j].asterisk = false;
+            board[i][j].isFixed = false;
+        }
+    }
+}
+
+/* returns true if all sudoku board cells are empty (UNASSIGNED), else returns false */
+bool board_is_empty(cell** board) {
+    int N = blockRows * blockCols;
+    if (count_empty_cells(board) != N * N){
+        return false;
+    }
+    return true;
+}
+
+/* returns a new sudoku board, generated by allocating memory and emptying the board */
+cell** generate_empty_board(){
+    int i, N;
+    cell** board = NULL;
+    N =  blockRows * blockCols;
+    board = calloc(N, sizeof (*board));
+    if (board == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    for (i = 0; i < N; i++) {
+        board[i] = NULL;
+        board[i] = calloc(N, sizeof (**board));
+        if (board[i] == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+    }
+    empty_board(board);
+    STATS_INC(boardAllocations);
+    return board;
+}
+
+/* copies a source sudoku board to a new identical sudoku board */
+void copy_board(cell** source_board, cell** new_board){
+    int i, j;
+    int N = blockRows * blockCols;
+    for (i  =0; i < N; i++) {
+        for (j = 0; j < N; j++){
+            new_board[i][j].number = source_board[i][j].number;
+            new_board[i][j].asterisk = source_board[i][j].asterisk;
+            new_board[i][j].isFixed = source_board[i][j].isFixed;
+        }
+    }
+}
+
+/* returns true if given value is in the sudoku board's block corresponding to the row and column given,
+ * else returns false.
+ * if encounters within the block in a cell containing the given value, it marks it with an asterisk */
+bool val_in_block(cell** board, int column, int row, int val){
+    bool valExist = false;
+    int initialCol, initialRow, colIndex, rowIndex;
+    initialCol = get_block_col_index(column);
+    initialRow = get_block_row_index(row);
+    for (colIndex = initialCol; (colIndex < blockCols + initialCol); colIndex++) {
+        for (rowIndex = initialRow; (rowIndex < blockRows + initialRow); rowIndex++) {
+            if ((colIndex == column - 1) && (rowIndex == row - 1)) { /* skips check for the cell about to change */ }
+            else if (board[rowIndex][colIndex].number == val) {
+                valExist = true;
+                if (board[rowIndex][colIndex].isFixed == false && board[rowIndex][colIndex].number != UNASSIGNED) { /* only marking unfixed cells */
+                    board[rowIndex][colIndex].asterisk = true;
+                }
+            }
+        }
+    }
+    return valExist;
+}
+
+/* returns true if given value is in the sudoku board's given row,
+ * else returns false.
+ * if encounters within the row in a cell containing the given value, it marks it with an asterisk */
+bool val_in_row(cell** board, int column, int row, int val){
+    int N = blockRows * blockCols;
+    bool valExist = false;
+    int colIndex;
+    for (colIndex = 0; colIndex < N; colIndex++) {
+        if(colIndex == column - 1) {/* not checking cell to be changed*/}
+        else if (board[row - 1][colIndex].number == val) {
+            valExist = true;
+            if (board[row - 1][colIndex].isFixed == false && board[row - 1][colIndex].number != UNASSIGNED) { /* only marking unfixed cells */
+                board[row - 1][colIndex].asterisk = true;
+            }
+        }
+    }
+    return valExist;
+}
+
+/* returns true if given value is in the sudoku board's given column,
+ * else returns false.
+ * if encounters within the column in a cell containing the given value, it marks it with an asterisk */
+bool val_in_column(cell** board, int column, int row, int val) {
+    /*
+     * Checks if value exist in the given column
+     */
+    int N = blockRows * blockCols;
+    bool valExist = false;
+    int rowIndex;
+    for (rowIndex = 0; rowIndex < N; rowIndex++) {
+        if(rowIndex == row - 1){/*not checking cell to be changed*/}
+        else if (board[rowIndex][column - 1].number == val) {
+            valExist = true;
+            if (board[rowIndex][column - 1].isFixed == false && board[rowIndex][column - 1].number != UNASSIGNED) { /* only marking unfixed cells */
+                board[rowIndex][column - 1].asterisk = true;
+            }
+        }
+    }
+    return valExist;
+}
+
+/* returns true if given value is valid in the cell corresponding to the row and column given in the sudoku board,
+ * else returns false.
+ * the valid check is done according to the game rules - checking row, column and block.
+ * if value is invalid it marks it with an asterisk */
+bool valid_check(cell** board, int column, int row, int val) {
+    if(val_in_block(board, column, row, val) | val_in_row(board, column, row, val) | val_in_column(board, column, row, val)){
+        if (val != UNASSIGNED) {
+            board[row - 1][column - 1].asterisk = true;
+            return false;
+        }
+        else{
+            board[row - 1][column - 1].asterisk = false;
+            return true;
+        }
+    }
+    else{
+        board[row - 1][column - 1].asterisk = false;
+        return true;
+    }
+
+}
+
+
+/* marks all cells in the sudoku board that contains invalid values according to game rules with an asterisk */
+void mark_asterisks(cell** board) {
+    int i, j;
+    int N = blockCols * blockRows;
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            if (board[i][j].number != UNASSIGNED) {
+                valid_check(board, j + 1, i + 1, board[i][j].number);
+            }
+        }
+    }
+}
+
+/* updates moves list by adding the cells of given sudoku board changed by a game move to the end of the list */
+void update_moves_list(cell** board, list* lst) {
+    insert_at_tail(board, lst);
+}
+
+/* prints the given sudoku board according to the format, game mode and markErrors value.
+ * boards are printed after commands only when not in quiet mode */
+void print_board(cell** board, char mode) {
+    if (!quietMode) {
+        render_board(commandOutput, board, mode);
+    }
+}
+
+/* returns true if given sudoku board contains erroneous cells (marked with an asterisk),
+ * else returns false */
+bool check_board_erroneous(cell **board){
+    int colIndex, rowIndex = 0;
+    int N = blockRows * blockCols;
+    for (rowIndex = 0; rowIndex < N; rowIndex++) {
+        for (colIndex = 0; colIndex < N; colIndex++) {
+            if (board[rowIndex][colIndex].asterisk) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* validates the given sudoku board using a cached solution or ILP and prints an appropriate message */
+void validate(cell** board) {
+    cell** copyBoard;
+    int solvable;
+    if (check_board_erroneous(board)) {
+        print_error(ERRONEOUS_ERROR );
+        return;
+    }
+    background_collect();
+    if (cache_lookup(board, boardHash, 0) != UNASSIGNED) {
+        fprintf(commandOutput, "Validation passed: board is solvable\n");
+        return;
+    }
+    copyBoard = duplicate_board(board);
+    solvable = ILP(board, copyBoard);
+    if (solvable == true) {
+        cache_store_board(boardHash, copyBoard);
+        fprintf(commandOutput, "Validation passed: board is solvable\n");
+    } else {
+        fprintf(commandOutput, "Validation failed: board is unsolvable\n");
+    }
+    free_board(copyBoard);
+}
+
+/* helper function to num_solutions that returns the number of solutions of the given sudoku board,
+ * using exhaustive deterministic backtrack within the given budget  */
+int count_solutions(cell** board, countBudget* budget) {
+    int numOfSolutions;
+    int* unassignedsArray;
+    cell** boardCopy = generate_empty_board();
+    copy_board(board, boardCopy);
+    unassignedsArray = get_next_play(boardCopy);
+    if (unassignedsArray[0] == -1) {
+        free(unassignedsArray);
+        return 0;
+    }
+    numOfSolutions = deterministic_backtrack(boardCopy, unassignedsArray[0], unassignedsArray[1], budget);
+    free_board(boardCopy);
+    free(unassignedsArray);
+    return numOfSolutions;
+}
+
+/* prints the number of solutions to out with an appropriate message, a count saturated at LONG_MAX as too many */
+void print_solutions_count(FILE* out, long solutionsCounter) {
+    if (solutionsCounter == LONG_MAX) {
+        fprintf(out, "Number of solutions: more than %ld, too many to count exactly\n", LONG_MAX - 1);
+    } else {
+        fprintf(out, "Number of solutions: %ld\n", solutionsCounter);
+    }
+    if (solutionsCounter == 1) {
+        fprintf(out, "This is a good board!\n");
+    } else if (solutionsCounter > 1) {
+        fprintf(out, "The puzzle has more than 1 solution, try to edit it further\n");
+    }
+}
+
+/* prints to out the lower bound on the number of solutions of a count which stopped early */
+void print_partial_count(FILE* out, const char* reason, long nodes, long solutions, double explored) {
+    fprintf(out, "%s after %ld nodes: at least %ld solutions, %.3g%% of the search tree explored\n",
+           reason, nodes, solutions, 100.0 * explored);
+}
+
+/* returns the node limit of the next counting slice, which doesn't pass the node budget (0 for no budget) */
+long next_slice_limit(long nodes, long maxNodes) {
+    if (maxNodes > 0 && nodes + JOB_SLICE_NODES > maxNodes) {
+        return maxNodes;
+    }
+    return nodes + JOB_SLICE_NODES;
+}
+
+/* counting job: counts the solutions of the job search context in slices of JOB_SLICE_NODES nodes,
+ * reporting the progress every JOB_PROGRESS_INTERVAL_NS until the search ends, the job is stopped
+ * or the budgets in the job arguments (milliseconds and nodes, 0 for no limit) are exhausted.
+ * only solutions canonical up to relabeling of the free digits are searched, each standing for orbit solutions,
+ * and the counts of repeated residual states are taken from a transposition table of the megabytes in the third job
+ * argument (0 for none) */
+void count_job(commandJob* job) {
+    bitSolver* s = job->s;
+    countTable* table = NULL;
+    long solutions = 0, orbit = 1, maxMs = job->args[0], maxNodes = job->args[1], megabytes = job->args[2];
+    int status, freeDigits;
+    bool exhausted = false;
+    double start = get_time_ns(), lastReport = start;
+    bit_search_begin(s);
+    for (freeDigits = bit_search_canonical(s); freeDigits > 1; freeDigits--) {
+        orbit = bit_count_add(0, orbit, freeDigits);
+    }
+    if (megabytes > 0) {
+        table = malloc(sizeof(countTable));
+        if (table == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+        count_table_init(table, megabytes);
+        s->table = table;
+    }
+    s->nodeLimit = next_slice_limit(0, maxNodes);
+    while ((status = bit_search_next(s)) != SEARCH_DONE) {
+        if (status == SEARCH_FOUND) {
+            solutions = bit_count_add(solutions, orbit, s->found);
+            continue;
+        }
+        if (job_stopped(job)) {
+            break;
+        }
+        if ((maxNodes > 0 && s->nodes >= maxNodes) || (maxMs > 0 && get_time_ns() - start >= maxMs * 1e6)) {
+            exhausted = true;
+            break;
+        }
+        s->nodeLimit = next_slice_limit(s->nodes, maxNodes);
+        if (!quietMode && get_time_ns() - lastReport >= JOB_PROGRESS_INTERVAL_NS) {
+            fprintf(job->out, "Progress: %ld nodes, %ld solutions so far, %.3g%% of the search tree explored\n",
+                    s->nodes, solutions, 100.0 * bit_search_progress(s));
+            fflush(job->out);
+            lastReport = get_time_ns();
+        }
+    }
+    if (status == SEARCH_DONE) {
+        print_solutions_count(job->out, solutions);
+    } else {
+        print_partial_count(job->out, exhausted ? "Search budget reached" : "Counting cancelled",
+                            s->nodes, solutions, bit_search_progress(s));
+    }
+    bit_search_end(s);
+    if (table != NULL) {
+        if (!quietMode) {
+            fprintf(job->out, "Transposition table: %ld lookups, %.1f%% hits, %ld counts stored, %ld replaced "
+                    "(%ld MB)\n", table->lookups, (table->lookups > 0) ? 100.0 * table->hits / table->lookups : 0.0,
+                    table->stores, table->replacements, megabytes);
+        }
+        count_table_free(table);
+        free(table);
+        s->table = NULL;
+    }
+}
+
+/* counts the number of solutions of the given sudoku board and prints it with an appropriate message.
+ * the count stops after maxMs milliseconds or maxNodes search nodes (0 for no limit) with a lower bound.
+ * boards which fit the bit solver are counted by a job, which reports progress and can be cancelled, the larger ones
+ * can't be cancelled so the server counts them within a budget only */
+void num_solutions(cell** board, long maxMs, long maxNodes) {
+    bitSolver* s;
+    countBudget budget;
+    long args[3] = {0, 0, 0};
+    long solutions;
+    if (check_board_erroneous(board)) {
+        print_error(ERRONEOUS_ERROR);
+        return;
+    }
+    if (blockRows * blockCols > MAX_BOARD_SIZE) {
+        if (serverMode && maxMs == 0 && maxNodes == 0) {
+            print_error("Error: boards larger than %dx%d are counted on the server within a budget only\n",
+                        MAX_BOARD_SIZE, MAX_BOARD_SIZE);
+            return;
+        }
+        budget.maxMs = maxMs;
+        budget.maxNodes = maxNodes;
+        budget.nodes = 0;
+        budget.explored = 0.0;
+        budget.exhausted = false;
+        solutions = count_solutions(board, &budget);
+        if (budget.exhausted) {
+            print_partial_count(commandOutput, "Search budget reached", budget.nodes, solutions, budget.explored);
+        } else {
+            print_solutions_count(commandOutput, solutions);
+        }
+        return;
+    }
+    args[0] = maxMs;
+    args[1] = maxNodes;
+    args[2] = countTableMegabytes; /* taken now, count_table may change it while the job runs */
+    s = malloc(sizeof(bitSolver));
+    if (s == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    bit_load_board(s, board);
+    job_start(count_job, NULL, board, NULL, s, args, NULL);
+}
+
+/* estimation job: estimates the number of solutions of the job search context with the budgets in the job arguments
+ * (milliseconds and probes), and prints the estimate with its confidence interval */
+void estimate_job(commandJob* job) {
+    solutionEstimate estimate;
+    char mean[ESTIMATE_FORMAT_SIZE], low[ESTIMATE_FORMAT_SIZE], high[ESTIMATE_FORMAT_SIZE];
+    double start = get_time_ns();
+    int threads = job_threads(job);
+    estimate_solutions(job->s, job->args[0], job->args[1], threads, &estimate);
+    if (job_stopped(job)) {
+        fprintf(job->out, "Estimation cancelled, estimating from the probes made so far\n");
+    }
+    if (estimate.hits == 0) {
+        fprintf(job->out, "Estimated solutions: 0 (none of %ld probes reached a solution)\n", estimate.probes);
+        return;
+    }
+    format_log10(estimate.logMean, mean);
+    format_log10(estimate.logLow, low);
+    format_log10(estimate.logHigh, high);
+    fprintf(job->out, "Estimated solutions: %s (log10 %.3f)\n", mean, estimate.logMean);
+    fprintf(job->out, "95%% confidence interval: %s - %s\n", low, high);
+    fprintf(job->out, "Probes: %ld, %ld reached a solution, %ld nodes in %.2f seconds on %d threads\n",
+            estimate.probes, estimate.hits, estimate.nodes, (get_time_ns() - start) / 1e9, threads);
+}
+
+/* estimates the number of solutions of the given sudoku board by random probes of its search tree,
+ * within maxMs milliseconds and maxProbes probes (0 for no limit, ESTIMATE_DEFAULT_MS when both are 0) */
+void estimate_command(cell** board, long maxMs, long maxProbes) {
+    bitSolver* s;
+    long args[3] = {0, 0, 0};
+    if (check_board_erroneous(board)) {
+        print_error(ERRONEOUS_ERROR);
+        return;
+    }
+    if (blockRows * blockCols > MAX_BOARD_SIZE) {
+        print_error("Error: board is too large for the estimator\n");
+        return;
+    }
+    s = malloc(sizeof(bitSolver));
+    if (s == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    bit_load_board(s, board);
+    prng_seed(&s->rng, prng_next(&gameRandom)); /* following the interactive random seed */
+    args[0] = (maxMs == 0 && maxProbes == 0) ? ESTIMATE_DEFAULT_MS : maxMs;
+    args[1] = maxProbes;
+    job_start(estimate_job, NULL, board, NULL, s, args, NULL);
+}
+
+/* enumeration job: writes the solutions of the job search context to the job path, up to the limit in the job
+ * arguments, and prints how the enumeration ended */
+void enumerate_job(commandJob* job) {
+    enumerationResult result;
+    int outcome = enumerate_solutions(job->s, job->path, job->args[0], &result);
+    if (outcome == ENUMERATE_CHECKPOINT_ERROR) {
+        job_error(job, "Error: %s%s is not a checkpoint of this board\n", job->path, ENUMERATE_CHECKPOINT_SUFFIX);
+        return;
+    }
+    if (result.resumed > 0) {
+        fprintf(job->out, "Resumed after %ld solutions\n", result.resumed);
+    }
+    if (outcome == ENUMERATE_FILE_ERROR) {
+        job_error(job, "Error: File cannot be written\n");
+    } else if (outcome == ENUMERATE_DONE) {
+        fprintf(job->out, "Enumerated %ld solutions to %s\n", result.solutions, job->path);
+    } else {
+        fprintf(job->out, "Enumeration %s after %ld solutions, enumerate %s again to resume\n",
+                (outcome == ENUMERATE_LIMIT) ? "reached the limit" : "cancelled", result.solutions, job->path);
+    }
+}
+
+/* writes the solutions of the given sudoku board to the given file path, at most limit of them (0 for no limit),
+ * resuming the enumeration of a previous run from its checkpoint */
+void enumerate_command(cell** board, char* filePath, long limit) {
+    bitSolver* s;
+    long args[3] = {0, 0, 0};
+    if (check_board_erroneous(board)) {
+        print_error(ERRONEOUS_ERROR);
+        return;
+    }
+    if (blockRows * blockCols > MAX_BOARD_SIZE) {
+        print_error("Error: board is too large for the enumerator\n");
+        return;
+    }
+    s = malloc(sizeof(bitSolver));
+    if (s == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    bit_load_board(s, board);
+    args[0] = limit;
+    job_start(enumerate_job, NULL, board, NULL, s, args, filePath);
+}
+
+/* writes a frontier of disjoint sub-problems of the given sudoku board, dealt into the given amount of shards
+ * which are counted by --count-shard processes and summed by --merge-shards */
+void export_frontier_command(cell** board, char* filePath, int shards) {
+    bitSolver* s;
+    long problems;
+    if (check_board_erroneous(board)) {
+        print_error(ERRONEOUS_ERROR);
+        return;
+    }
+    if (blockRows * blockCols > MAX_BOARD_SIZE) {
+        print_error("Error: board is too large for sharded counting\n");
+        return;
+    }
+    s = malloc(sizeof(bitSolver));
+    if (s == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    bit_load_board(s, board);
+    problems = export_frontier(s, filePath, shards);
+    free(s);
+    if (problems < 0) {
+        print_error("Error: File cannot be created or modified\n");
+        return;
+    }
+    fprintf(commandOutput, "Exported %ld sub-problems in %d shards to %s\n", problems, shards, filePath);
+}
+
+/* saves the given sudoku board to the given file path */
+void save_command(cell** board, char* filePath) {
+    FILE* fp;
+    int i, j, N;
+    cell** copyOfBoard;
+    bool solvable;
+    if (mode == 'E') {
+        if (check_board_erroneous(board)) { /* board to be saved in 'E' mode must'nt contain errors */
+            print_error(ERRONEOUS_ERROR);
+            return;
+        }
+        solvable = (cache_lookup(board, boardHash, 0) != UNASSIGNED);
+        if (!solvable) {
+            copyOfBoard = generate_empty_board();
+            solvable = ILP(board,copyOfBoard);
+            if (solvable) {
+                cache_store_board(boardHash, copyOfBoard);
+            }
+            free_board(copyOfBoard);
+        }
+        if (!solvable) { /* board to be saved in 'E' mode must be solvable */
+            print_error("Error: board validation failed\n");
+            return;
+        }
+    }
+    if ((fp = fopen(filePath, "wb")) == NULL) { /* file does not exist or can't be open */
+        print_error("Error: File cannot be created or modified\n");
+        return;
+    }
+    if (!board_file_write_header(fp, blockRows, blockCols)){ /* failed to write */
+        print_error("Writing to file failed. Game not saved\n");
+        fclose(fp);
+        return;
+    }
+    N = blockRows * blockCols;
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) { /* every value is fixed in 'E' mode */
+            board_file_write_cell(fp, board[i][j].number, board[i][j].isFixed || mode == 'E', j == N - 1);
+        }
+    }
+    fclose(fp);
+    fprintf(commandOutput, "Saved to: %s\n", filePath);
+}
+
+/* sets global variable markErrors with legal given value  */
+void mark_errors_command(int value) {
+    if (value == 0) {
+        markErrors = 0;
+    } else if (value == 1) {
+        markErrors = 1;
+    }
+    else {
+        print_error(MARK_ERROR_ERROR);
+    }
+}
+
+/* loads a sudoku board from given board file, setting the board dimensions.
+ * if the file is not a valid board prints an appropriate error message, keeps the dimensions and returns NULL */
+cell** load_board(FILE* fp, char mode){
+    int i, j, N, value;
+    int oldRows = blockRows, oldCols = blockCols;
+    char mark;
+    cell** board = NULL;
+    if (!board_file_read_header(fp, BOARD_FILE_MAX_SIZE, &blockRows, &blockCols)) {
+        blockRows = oldRows;
+        blockCols = oldCols;
+        print_error("Error: File read failed\n");
+        return NULL;
+    }
+    board = generate_empty_board();
+    N = blockRows * blockCols;
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            if (!board_file_read_cell(fp, N, &value, &mark)) {
+                free_board(board);
+                blockRows = oldRows;
+                blockCols = oldCols;
+                print_error("Error: File read failed\n");
+                return NULL;
+            }
+            board[i][j].number = value;
+            if ((mark == '.') && (mode == 'S')) {  /* cells are marked as fixes only in 'S' mode */
+                board[i][j].isFixed = true;
+            }
+            else if (mark == '*') {
+                board[i][j].asterisk = true;
+            }
+        }
+    }
+    mark_asterisks(board);
+    return board;
+}
+
+/* returns a sudoku board to be edited:
+ * loading an existing sudoku board from given file path or generating a new 9X9 board.
+ * if succeeded prints the board, else prints an appropriate error message */
+cell** edit_command(char* parsedCommand[4], char mode){
+    cell** board = NULL;
+    FILE* fp = NULL;
+    if (parsedCommand[1] != NULL){
+        fp = fopen(parsedCommand[1], "r");
+        if (fp != NULL) {
+            board = load_board(fp, mode);
+            fclose(fp);
+        }
+        else {
+            print_error("Error: File cannot be opened\n");
+            return board;
+        }
+    } else {
+        blockRows = 3;
+        blockCols = 3;
+        board = generate_empty_board();
+    }
+    if (board != NULL) {
+        print_board(board, mode);
+    }
+    return board;
+}
+
+/* returns a new sudoku board to be edited, made by applying a random validity preserving transform
+ * to the seed board loaded from given file path.
+ * if succeeded prints the board, else prints an appropriate error message */
+cell** generate_from_command(char* parsedCommand[4], char mode){
+    cell** board = NULL;
+    FILE* fp = NULL;
+    int* grid;
+    int i, j, N;
+    int oldRows = blockRows, oldCols = blockCols;
+    if (parsedCommand[1] == NULL){
+        print_error(INVALID_ERROR);
+        return board;
+    }
+    fp = fopen(parsedCommand[1], "r");
+    if (fp == NULL) {
+        print_error("Error: File doesn't exist or cannot be opened\n");
+        return board;
+    }
+    board = load_board(fp, mode);
+    fclose(fp);
+    if (board == NULL) {
+        return board;
+    }
+    N = blockRows * blockCols;
+    if (N > MAX_BOARD_SIZE) {
+        print_error("Error: board is too large to be transformed\n");
+        free_board(board);
+        blockRows = oldRows; /* the current board stays */
+        blockCols = oldCols;
+        return NULL;
+    }
+    grid = malloc(N * N * sizeof(int));
+    if (grid == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            grid[i * N + j] = board[i][j].number;
+        }
+    }
+    transform_grid(&gameRandom, grid, blockRows, blockCols);
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            board[i][j].number = grid[i * N + j];
+            board[i][j].asterisk = false;
+        }
+    }
+    free(grid);
+    mark_asterisks(board); /* the transform keeps conflicts, but moves them to other cells */
+    print_board(board, mode);
+    return board;
+}
+
+/* returns a sudoku board to be solved:
+ * loading an existing sudoku board from given file path.
+ * if succeeded prints the board, else prints an appropriate error message */
+cell** solve_command(char* parsedCommand[4], char mode){
+    cell** board = NULL;
+    FILE* fp = NULL;
+    if (parsedCommand[1] == NULL){
+        print_error(INVALID_ERROR);
+        return board;
+    }
+    fp = fopen(parsedCommand[1], "r");
+    if (fp != NULL) {
+        board = load_board(fp, mode);
+        fclose(fp);
+        if (board != NULL) {
+            print_board(board, mode);
+        }
+    } else {
+        print_error("Error: File doesn't exist or cannot be opened\n");
+    }
+    return board;
+}
+
+
+/* checks if given sudoku board is completely full and solved successfully according to the game rules,
+ * using ILP for validation.
+ * if solved - prints appropriate message, updating game mode to 'I' and gameOver flag to true.
+ * if full and solved incorrectly prints appropriate message and not changing game mode or gameOver flag. */
+void game_over(cell** board){
+    int col, row;
+    bool solvable;
+    bool full = true;
+    cell** copyBoard;
+    int N = blockCols * blockRows;
+    for (col = 0; col < N; col++) {
+        for (row = 0; row < N; row++) {
+            if (board[row][col].number == UNASSIGNED) {
+                full = false;
+            }
+        }
+    }
+    if (full) {
+        background_collect(); /* a full board agreeing with the solution of the previous position is solved */
+        solvable = (cache_lookup(board, boardHash, 0) != UNASSIGNED);
+        if (!solvable) {
+            copyBoard = generate_empty_board();
+            solvable = ILP(board, copyBoard);
+            free_board(copyBoard);
+        }
+        if (solvable) {
+            fprintf(commandOutput, GAME_OVER);
+            mode = 'I';
+            gameOver = true;
+        } else {
+            fprintf(commandOutput, "Puzzle solution erroneous\n");
+        }
+    }
+}
+
+/* helper function which validates asterisks after a new set of value in the given indexes was made.
+ * returns true if at least one cell was found to be invalid, else return false.
+ * if previously asterisk cell is now valid it updates asterisk to false
+ * if new risks are found, it marks them with an asterisk */
+bool validate_risks(cell** board, int column, int row) {
+    int initialCol, initialRow, colIndex, rowIndex;
+    int N = blockRows * blockCols;
+    bool risksFound = true;
+    initialCol = get_block_col_index(column);
+    initialRow = get_block_row_index(row);
+    for (colIndex = initialCol; (colIndex < blockCols + initialCol); colIndex++) { /* block check */
+        for (rowIndex = initialRow; (rowIndex < blockRows + initialRow); rowIndex++) {
+            if (colIndex == (column - 1) && rowIndex == (row - 1)) { /* not checking cell changed */
+            }
+            else if (board[rowIndex][colIndex].asterisk){
+                if(valid_check(board, colIndex + 1, rowIndex + 1, board[rowIndex][colIndex].number)){
+                    board[rowIndex][colIndex].asterisk = false;
+                }
+                else{
+                    risksFound = false;
+                }
+            }
+        }
+    }
+    for (colIndex = 0; (colIndex < N); colIndex++) { /* row check */
+        if (colIndex == column - 1) {
+        }
+        else if (board[row - 1][colIndex].asterisk){
+            if (valid_check(board, colIndex + 1, row, board[row - 1][colIndex].number)){
+                board[row - 1][colIndex].asterisk = false;
+            }
+            else{
+                risksFound = false;
+            }
+        }
+    }
+
+    for (rowIndex = 0; (rowIndex < N); rowIndex++) {  /* col check */
+        if (rowIndex == row - 1){
+        }
+        else if (board[rowIndex][column - 1].asterisk){
+            if( valid_check(board, column , rowIndex + 1, board[rowIndex][column - 1].number)){
+                board[rowIndex][column - 1].asterisk = false;
+            }
+            else{
+                risksFound = false;
+            }
+        }
+    }
+    return risksFound;
+}
+
+/* fills cells in given sudoku board which can contain a single legal value.
+ * returns true if at least one cell was filled, else returns false */
+bool auto_fill(cell** board)    {
+    int i, j, k, candidate;
+    int fillFlag = false;
+    int numOfCandidates = 0;
+    int maxValue = blockRows * blockCols + 1;
+    cell** copyOfBoard;
+    int N = blockRows * blockCols;
+    if (check_board_erroneous(board)){
+        print_error(ERRONEOUS_ERROR);
+        return false;
+    }
+    copyOfBoard = generate_empty_board();
+    copy_board(board, copyOfBoard);
+    for (i = 0; i < N; i++){
+        for (j = 0; j < N; j++){
+            if (copyOfBoard[i][j].number == UNASSIGNED){
+                for (k = 1; k < maxValue; k++){
+                    if (valid_check(copyOfBoard, j + 1, i + 1, k)){
+                        candidate = k;
+                        numOfCandidates++;
+                    }
+                }
+                if (numOfCandidates == 1){
+                    board[i][j].number = candidate;
+                    update_board_hash(j + 1, i + 1, UNASSIGNED, candidate);
+                    validate_risks(board, j + 1, i + 1);
+                    fillFlag = true;
+                    fprintf(commandOutput, "Cell <%d,%d> set to %d\n", (j+1), (i+1), candidate);
+                }
+                numOfCandidates = 0;
+            }
+        }
+    }
+    free_board(copyOfBoard);
+    print_board(board, mode);
+    game_over(board);
+    return fillFlag;
+}
+
+/* sets given value to corresponding cell(according to indexes given) in given sudoku board.
+ * if either value or indexes are invalid or cell is fixed prints appropriate error message.
+ * validating asterisks to update marking of asterisks cells if needed.
+ * checks if game is over after the set was made.
+ * returns true if s set which changed the board status was made, else return false.
+ * prints the board if set was successful */
+bool set(cell** board, int column, int row, int val, char mode) {
+    int N = blockRows * blockCols;
+    if((!valid_board_index(column, N)) || (!valid_board_index(row, N)) || (!valid_set_value(val, N))){
+        print_error(VALUE_RANGE_ERROR, blockCols * blockRows);
+        return false;
+    }
+    if (board[row - 1][column - 1].isFixed) {
+        print_error(FIXED_ERROR);
+        return false;
+    }
+    else if (board[row - 1][column - 1].number == val) {
+        print_board(board, mode);
+        return  false;
+    }
+    else if (val == 0) {
+        update_board_hash(column, row, board[row - 1][column - 1].number, UNASSIGNED);
+        board[row - 1][column - 1].number = UNASSIGNED;
+        board[row - 1][column - 1].asterisk = false;
+        validate_risks(board, column, row);
+        print_board(board, mode);
+        return true;
+    }
+    else {
+        valid_check(board, column, row, val);
+        update_board_hash(column, row, board[row - 1][column - 1].number, val);
+        board[row - 1][column - 1].number = val;
+        validate_risks(board, column, row);
+        print_board(board, mode);
+        if (mode == 'S'){
+            game_over(board);
+        }
+        return true;
+    }
+}
+
+/* prints a valid hint value of the corresponding cell(according to indexes given) in the given sudoku board.
+ * hint value comes from a cached solution, else from logical techniques when they solve the board,
+ * else from solving the board using ILP.
+ * if either indexes are invalid, board contains errors, cell is fixed or full prints appropriate error message.
+ * if board is unsolvable prints appropriate error message.
+ */
+void hint(cell** board, int column, int row){
+    int hint, technique, cached;
+    long steps;
+    bool solvable;
+    bitSolver* s;
+    int solution[MAX_BOARD_CELLS];
+    cell** solvedBoard = NULL;
+    int N = blockCols * blockRows;
+    if((!valid_board_index(column, N)) || (!valid_board_index(row, N))) {
+        print_error("Error: value not in range 1-%d\n",N);
+        return;
+    }
+    if (check_board_erroneous(board)) {
+        print_error(ERRONEOUS_ERROR);
+        return;
+    }
+    if (board[row - 1][column - 1].isFixed) {
+        print_error(FIXED_ERROR);
+        return;
+    }
+    if (board[row - 1][column - 1].number != 0) {
+        print_error("Error: cell already contains a value\n");
+        return;
+    }
+    background_collect();
+    cached = cache_lookup(board, boardHash, (row - 1) * N + (column - 1));
+    if (cached != UNASSIGNED) {
+        fprintf(commandOutput, "Hint: set cell to %d\n", cached);
+        fprintf(commandOutput, "Technique: cached solution\n");
+        return;
+    }
+    if (N <= MAX_BOARD_SIZE) { /* logical deduction first, the ILP only when logic gets stuck */
+        s = malloc(sizeof(bitSolver));
+        if (s == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+        bit_load_board(s, board);
+        hint = deduce_cell(s, (row - 1) * N + (column - 1), &technique, &steps, solution);
+        free(s);
+        if (hint == GRADE_CONTRADICTION) {
+            print_error("Error: board is unsolvable\n");
+            return;
+        }
+        if (hint != GRADE_STUCK) {
+            cache_store(boardHash, solution);
+            fprintf(commandOutput, "Hint: set cell to %d\n", hint);
+            if (steps == 0) {
+                fprintf(commandOutput, "Technique: %s\n", technique_name(technique));
+            } else {
+                fprintf(commandOutput, "Technique: %s, after %ld earlier logical steps\n", technique_name(technique),
+                        steps);
+            }
+            return;
+        }
+    }
+    solvedBoard = generate_empty_board();
+    solvable = ILP(board, solvedBoard);
+    if (solvable == false){
+        print_error("Error: board is unsolvable\n");
+        free_board(solvedBoard);
+        return;
+    }
+    else{
+        cache_store_board(boardHash, solvedBoard);
+        hint = solvedBoard[row - 1][column - 1].number;
+        fprintf(commandOutput, "Hint: set cell to %d\n", hint);
+        fprintf(commandOutput, "Technique: full solve\n");
+        free_board(solvedBoard);
+    }
+}
+
+/* frees allocated memory of given sudoku board */
+void free_board(cell** board){
+    int i;
+    int N = blockRows * blockCols;
+    for (i = 0; i < N; i++) {
+        free(board[i]);
+    }
+    free(board);
+    board = NULL;
+
+}
+/* frees allocated memory for given command, exists the game after printing appropriate message */
+void exit_game(char* command){
+    fprintf(commandOutput, "Exiting...\n");
+    free(command);
+    background_enable(false);
+    cache_free();
+    exit(0);
+}
+
+/* fills the corresponding cell(according to indexes given) in the given sudoku board with a random legal value,
+ * if no value found returns false, else returns true */
+bool fill_cell(cell** board, int column, int row){
+    cell** copyOfBoard;
+    int numbersLeft, randomIndex, nextNum;
+    int N = blockRows * blockCols;
+    int* availableNumbers;
+    availableNumbers = generate_int_array(N); /* int pointer containing available numbers to be filled from 1-N */
+    copyOfBoard = generate_empty_board();
+    copy_board(board, copyOfBoard);
+    numbersLeft = N;
+    while (numbersLeft > 0){
+        randomIndex = prng_below(&gameRandom, numbersLeft);
+        nextNum = availableNumbers[randomIndex];
+        if(valid_check(copyOfBoard, column + 1 ,row + 1, nextNum)){
+            copyOfBoard[row][column].number = nextNum;
+            copy_board(copyOfBoard, board); /* updating original board */
+            free_board(copyOfBoard);
+            free(availableNumbers);
+            return true;
+        }
+        copyOfBoard[row][column].number = UNASSIGNED;
+        copyOfBoard[row][column].asterisk = false;
+        numbersLeft--;
+        if (numbersLeft > 0) {
+            delFromArr(randomIndex, numbersLeft, availableNumbers); /* updating available numbers by deleting illegals*/
+        }
+    }
+    free_board(copyOfBoard); /* no legal value was found */
+    free(availableNumbers);
+    return false;
+}
+
+/* generates a random solved board using ILP, for boards too large for the bit solver:
+ * first step: filling board with amount of initialFullCells of random legal values
+ * if first step is successful - second step: validating board to using ILP to see if solvable
+ * if second step is successful - third step :  copying valid amont of random copyCells to the given board.
+ * when either step one or two fails board is emptying and process starts again from first step
+ * returns true on success, false after 1000 failed attempts */
+bool generate_with_ilp(cell** board, int initialFullCells, int copyCells) {
+    cell **newBoard;
+    bool solvable;
+    int randCol, randRow;
+    int cellsFilled = 0;
+    int triesLeft = 1000;
+    int N = blockCols * blockRows;
+    while (triesLeft > 0) {
+        if (cellsFilled < initialFullCells) {
+            randCol = prng_below(&gameRandom, N);
+            randRow = prng_below(&gameRandom, N);
+            if (board[randRow][randCol].number == UNASSIGNED) {
+                if (!fill_cell(board, randCol, randRow)) { /* failed to find legal value to cell chosen */
+                    triesLeft--;
+                    empty_board(board);
+                    cellsFilled = 0;
+                } else {
+                    cellsFilled++;
+                }
+            }
+        }
+        else if (cellsFilled == initialFullCells) {
+            newBoard = generate_empty_board();
+            solvable = ILP(board, newBoard);
+            empty_board(board);
+            if (solvable) {
+                copy_random_cells(newBoard, copyCells, board);
+                free_board(newBoard);
+                return true;
+            } else { /* failed to solve board */
+                triesLeft--;
+                empty_board(board);
+                free_board(newBoard);
+                cellsFilled = 0;
+            }
+        }
+    }
+    return false;
+}
+
+/* generation job: generates a random full grid in the job search context, with initialFullCells random cells
+ * in the first job argument, and keeps whether it succeeded in the third */
+void generate_job(commandJob* job) {
+    bitSolver* s = job->s;
+    job->args[2] = generate_full_grid_speculative(s, s->blockRows, s->blockCols, (int) job->args[0], GENERATOR_TRIES,
+                                                  job_threads(job));
+}
+
+/* finishes a generation job on the main loop: copies the amount of random cells in the second job argument from the
+ * grid to the board, prints it and records it in the moves list, unless the generation failed or was cancelled */
+void generate_finish(commandJob* job) {
+    cell** newBoard;
+    if (job_stopped(job) || !job->args[2]) {
+        print_error(job_stopped(job) ? "Error: generation cancelled\n" : "Error: puzzle generator failed\n");
+        return;
+    }
+    newBoard = generate_empty_board();
+    bit_store_board(job->s, newBoard);
+    copy_random_cells(newBoard, (int) job->args[1], job->board);
+    free_board(newBoard);
+    print_board(job->board, mode);
+    if (!board_is_empty(job->board)) {
+        boardHash = board_hash(job->board);
+        update_moves_list(job->board, job->lst);
+    }
+}
+
+/* generates a random sudoku board by filling the empty board given:
+ * first step: generating a random complete grid, initialFullCells random cells are filled with random legal values
+ * and the rest of the grid is completed by a randomized bitmask backtracking search (see generator)
+ * second step: copying valid amount of random copyCells of the grid to the given board.
+ * a failed first step (dead end, or too many search nodes) is retried with new random cells,
+ * attempts run speculatively on all processors in a job (on one on the server), which can be cancelled, and the first
+ * grid generated is used
+ * boards with more than MAX_BOARD_SIZE symbols do not fit the bit solver and are generated using ILP at once instead
+ * after 1000 failed attempts an appropriate error message is printed.
+ * if generation is successful the given board is updated, printed and recorded in the moves list */
+void generate_randomized_solved_board(cell** board, list* lst, int initialFullCells, int copyCells) {
+    bitSolver* s;
+    int emptyCellsCounter;
+    long args[3] = {0, 0, 0};
+    emptyCellsCounter = count_empty_cells(board);
+    if ((!valid_set_value(initialFullCells, emptyCellsCounter)) || (!valid_set_value(copyCells, emptyCellsCounter))) {
+        print_error(VALUE_RANGE_ERROR, emptyCellsCounter);
+        return;
+    }
+    if (!board_is_empty(board)) {
+        print_error("Error: board is not empty\n");
+        return;
+    }
+    if (blockRows * blockCols > MAX_BOARD_SIZE) {
+        if (!generate_with_ilp(board, initialFullCells, copyCells)) {
+            print_error("Error: puzzle generator failed\n");
+            return;
+        }
+        print_board(board, mode);
+        if (!board_is_empty(board)) {
+            boardHash = board_hash(board);
+            update_moves_list(board, lst);
+        }
+        return;
+    }
+    s = malloc(sizeof(bitSolver));
+    if (s == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    bit_init(s, blockRows, blockCols);
+    prng_seed(&s->rng, prng_next(&gameRandom)); /* following the interactive random seed */
+    args[0] = initialFullCells;
+    args[1] = copyCells;
+    job_start(generate_job, generate_finish, board, lst, s, args, NULL);
+}
+
+/* unique generation job: digs a puzzle with a unique solution and the target clues in the first job argument
+ * in the job search context, symmetrically if the second argument is set, and keeps its clues in the third */
+void generate_unique_job(commandJob* job) {
+    bitSolver* s = job->s;
+    job->args[2] = generate_unique(s, s->blockRows, s->blockCols, (int) job->args[0], (bool) job->args[1], NULL);
+}
+
+/* finishes a unique generation job on the main loop: stores the puzzle in the board, prints it and records it
+ * in the moves list, unless the generation failed or was cancelled */
+void generate_unique_finish(commandJob* job) {
+    if (job_stopped(job) || job->args[2] < 0) {
+        print_error(job_stopped(job) ? "Error: generation cancelled\n" : "Error: puzzle generator failed\n");
+        return;
+    }
+    bit_store_board(job->s, job->board);
+    print_board(job->board, mode);
+    if (job->args[2] > job->args[0]) { /* stopped because no clue could be removed */
+        fprintf(commandOutput, "Puzzle is minimal with %ld clues\n", job->args[2]);
+    } else {
+        fprintf(commandOutput, "Generated a puzzle with %ld clues\n", job->args[2]);
+    }
+    boardHash = board_hash(job->board);
+    update_moves_list(job->board, job->lst);
+}
+
+/* generates a random puzzle with a unique solution into the empty board given, by digging holes in a random full grid.
+ * clues are removed until the puzzle has targetClues clues (0 for as few as possible) or no clue can be removed.
+ * the generation runs in a job, which can be cancelled; if it is successful the given board is updated, printed
+ * and recorded in the moves list */
+void generate_unique_board(cell** board, list* lst, int targetClues, bool symmetric) {
+    bitSolver* s;
+    int N = blockRows * blockCols;
+    long args[3] = {0, 0, 0};
+    if (targetClues < 0 || targetClues > N * N) {
+        print_error(VALUE_RANGE_ERROR, N * N);
+        return;
+    }
+    if (!board_is_empty(board)) {
+        print_error("Error: board is not empty\n");
+        return;
+    }
+    if (N > MAX_BOARD_SIZE) {
+        print_error("Error: board is too large for the unique generator\n");
+        return;
+    }
+    s = malloc(sizeof(bitSolver));
+    if (s == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    bit_init(s, blockRows, blockCols);
+    prng_seed(&s->rng, prng_next(&gameRandom)); /* following the interactive random seed */
+    args[0] = targetClues;
+    args[1] = symmetric;
+    job_start(generate_unique_job, generate_unique_finish, board, lst, s, args, NULL);
+}
+
+/* grades the difficulty of the given sudoku board by the logical techniques needed to solve it,
+ * prints the level, the score and the amount of steps of every technique used */
+void grade_command(cell** board) {
+    bitSolver* s;
+    gradeResult result;
+    int technique;
+    if (check_board_erroneous(board)) {
+        print_error(ERRONEOUS_ERROR);
+        return;
+    }
+    if (blockRows * blockCols > MAX_BOARD_SIZE) {
+        print_error("Error: board is too large for the grader\n");
+        return;
+    }
+    s = malloc(sizeof(bitSolver));
+    if (s == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    bit_load_board(s, board);
+    grade_puzzle(s, &result);
+    free(s);
+    fprintf(commandOutput, "Difficulty: %s (score %ld)\n", grade_level(&result), result.score);
+    for (technique = 0; technique < TECHNIQUES; technique++) {
+        if (result.steps[technique] > 0) {
+            fprintf(commandOutput, "  %s: %ld\n", technique_name(technique), result.steps[technique]);
+        }
+    }
+    if (result.contradiction) {
+        fprintf(commandOutput, "The board has no solution\n");
+    } else if (!result.solved) {
+        fprintf(commandOutput, "Logical techniques got stuck with %d empty cells left\n", result.left);
+    }
+}
+
+/* evaluates the user-entered game command and calls the relevant function to execute it.
+ * performs preliminary input checks before calling the relevant function,
+ * prints an appropriate error message when necessary.
+ * updates the moves list in each step that changed the status of the given sudoku board */
+void execute_command(char* parsedCommand[4], cell** board, char* command, int counter, char mode, list* lst){
+    bool cmdExecuted = false;
+    int N = blockRows *blockCols;
+    int i;
+    long args[3] = {0, 0, 0};
+    if (strcmp(parsedCommand[0], "set") == 0 && counter == 4 && (mode == 'E' || mode == 'S')) {
+        if ((!is_integer(parsedCommand[1])) || (!is_integer(parsedCommand[2])) || (!is_integer(parsedCommand[3]))){
+            print_error(VALUE_RANGE_ERROR, N);
+            return;
+        }
+        cmdExecuted = set(board, atoi(parsedCommand[1]), atoi(parsedCommand[2]), atoi(parsedCommand[3]), mode);
+        if (cmdExecuted) {
+            update_moves_list(board, lst);
+        }
+    } else if (strcmp(parsedCommand[0], "hint") == 0 && counter >= 3 && mode == 'S') {
+        if ((!is_integer(parsedCommand[1])) || (!is_integer(parsedCommand[2]))){
+            print_error("Error: value not in range 1-%d\n",N);
+            return;
+        }
+        hint(board, atoi(parsedCommand[1]), atoi(parsedCommand[2]));
+    } else if (strcmp(parsedCommand[0], "validate") == 0  && (mode == 'E' || mode == 'S')) {
+        validate(board);
+    } else if ((strcmp(parsedCommand[0], "print_board") == 0) && (mode == 'E' || mode == 'S')) {
+        render_board(commandOutput, board, mode); /* printed even in quiet mode */
+    } else if (strcmp(parsedCommand[0], "mark_errors") == 0 && counter >= 2 && (mode == 'S')) {
+        if (!is_integer(parsedCommand[1])) {
+            print_error(MARK_ERROR_ERROR);
+            return;
+        }
+        mark_errors_command(atoi(parsedCommand[1]));
+    } else if (strcmp(parsedCommand[0], "autofill") == 0 && mode == 'S') {
+        cmdExecuted = auto_fill(board);
+        if (cmdExecuted) {
+            update_moves_list(board, lst);
+        }
+    } else if (strcmp(parsedCommand[0], "save") == 0 && counter >= 2 && (mode == 'E' || mode == 'S')) {
+        save_command(board, parsedCommand[1]);
+    } else if (strcmp(parsedCommand[0], "num_solutions") == 0 && (mode == 'E' || mode == 'S')) {
+        for (i = 1; i < counter && i <= 2; i++) { /* optional time and node budgets */
+            if (!is_integer(parsedCommand[i]) || parsedCommand[i][0] == '-') {
+                print_error("Error: budgets should be non negative integers\n");
+                return;
+            }
+            args[i - 1] = atol(parsedCommand[i]);
+        }
+        num_solutions(board, args[0], args[1]);
+    } else if (strcmp(parsedCommand[0], "enumerate") == 0 && counter >= 2 && (mode == 'E' || mode == 'S')) {
+        if (counter >= 3 && (!is_integer(parsedCommand[2]) || parsedCommand[2][0] == '-')) {
+            print_error("Error: limit should be a non negative integer\n");
+            return;
+        }
+        enumerate_command(board, parsedCommand[1], (counter >= 3) ? atol(parsedCommand[2]) : 0);
+    } else if (strcmp(parsedCommand[0], "export_frontier") == 0 && counter >= 3 && (mode == 'E' || mode == 'S')) {
+        if (!is_integer(parsedCommand[2]) || atol(parsedCommand[2]) < 1 || atol(parsedCommand[2]) > FRONTIER_MAX_SHARDS) {
+            print_error("Error: amount of shards should be 1-%d\n", FRONTIER_MAX_SHARDS);
+            return;
+        }
+        export_frontier_command(board, parsedCommand[1], atoi(parsedCommand[2]));
+    } else if (strcmp(parsedCommand[0], "count_table") == 0 && counter >= 2) {
+        if (!is_integer(parsedCommand[1]) || parsedCommand[1][0] == '-') {
+            print_error("Error: table size should be a non negative amount of megabytes\n");
+            return;
+        }
+        countTableMegabytes = atol(parsedCommand[1]); /* 0 counts without a table */
+    } else if (strcmp(parsedCommand[0], "estimate_solutions") == 0 && (mode == 'E' || mode == 'S')) {
+        for (i = 1; i < counter && i <= 2; i++) { /* optional time and probes budgets */
+            if (!is_integer(parsedCommand[i]) || parsedCommand[i][0] == '-') {
+                print_error("Error: budgets should be non negative integers\n");
+                return;
+            }
+            args[i - 1] = atol(parsedCommand[i]);
+        }
+        estimate_command(board, args[0], args[1]);
+    } else if (strcmp(parsedCommand[0], "grade") == 0 && (mode == 'E' || mode == 'S')) {
+        grade_command(board);
+    } else if (strcmp(parsedCommand[0], "generate") == 0 && counter >= 3 && mode == 'E' ) {
+        if ((!is_integer(parsedCommand[1])) || (!is_integer(parsedCommand[2]))){
+            print_error(VALUE_RANGE_ERROR, count_empty_cells(board));
+            return;
+        }
+        generate_randomized_solved_board(board, lst, atoi(parsedCommand[1]), atoi(parsedCommand[2]));
+    } else if (strcmp(parsedCommand[0], "generate_unique") == 0 && counter >= 2 && mode == 'E') {
+        if (!is_integer(parsedCommand[1])) {
+            print_error(VALUE_RANGE_ERROR, N * N);
+            return;
+        }
+        if (counter >= 3 && strcmp(parsedCommand[2], "symmetric") != 0 && strcmp(parsedCommand[2], "random") != 0) {
+            print_error("Error: removal order should be random or symmetric\n");
+            return;
+        }
+        generate_unique_board(board, lst, atoi(parsedCommand[1]),
+                              counter >= 3 && strcmp(parsedCommand[2], "symmetric") == 0);
+    } else if (((strcmp(parsedCommand[0], "undo") == 0)) && (mode == 'E' || mode == 'S')) {
+        undo(lst, board, mode);
+    } else if (((strcmp(parsedCommand[0], "redo") == 0)) && (mode == 'E' || mode == 'S')) {
+        redo(lst, board, mode);
+    } else if (((strcmp(parsedCommand[0], "reset") == 0)) && (mode == 'E' || mode == 'S')) {
+        reset(lst, board, mode);
+    } else if (strcmp(parsedCommand[0], "speculate") == 0 && counter >= 2) {
+        if (!is_integer(parsedCommand[1]) || (atoi(parsedCommand[1]) != 0 && atoi(parsedCommand[1]) != 1)) {
+            print_error(MARK_ERROR_ERROR);
+            return;
+        }
+        if (serverMode) { /* the background solver follows the console game only */
+            print_error("Error: speculate is not available on the server\n");
+            return;
+        }
+        background_enable(atoi(parsedCommand[1]) == 1); /* solve mode positions are solved while the user thinks */
+    } else if (strcmp(parsedCommand[0], "seed") == 0 && counter >= 2) {
+        if (!is_integer(parsedCommand[1]) || parsedCommand[1][0] == '-') {
+            print_error("Error: seed should be a non negative integer\n");
+            return;
+        }
+        prng_seed(&gameRandom, strtoul(parsedCommand[1], NULL, 10)); /* makes the following random commands reproducible */
+#ifndef SUDOKU_NO_STATS
+    } else if (strcmp(parsedCommand[0], "stats") == 0) {
+        if (counter >= 2 && strcmp(parsedCommand[1], "json") != 0) {
+            print_error("Error: stats format should be json\n");
+            return;
+        }
+        stats_command(counter >= 2);
+#endif
+    } else if (strcmp(parsedCommand[0], "cancel") == 0) {
+        if (!job_cancel()) {
+            print_error("Error: no command is running\n");
+        }
+    } else if (strcmp(parsedCommand[0], "exit") == 0) {
+        job_cancel();
+        if (mode != 'I' || gameOver) {
+            free_board(board);
+            free_list(lst);
+        }
+        exit_game(command);
+    } else {
+        print_error(INVALID_ERROR);
+    }
+}
+
+/* replaces the board and moves list of the game with a copy of the loaded board, freeing the old ones
+ * (which have the old dimensions) unless there were none */
+void replace_board(cell** loadedBoard, cell*** board, list** movesList, int oldRows, int oldCols, char newMode) {
+    int newRows = blockRows, newCols = blockCols;
+    cell** startingBoard;
+    if (mode != 'I' || gameOver) { /* switching from another game */
+        blockRows = oldRows;
+        blockCols = oldCols;
+        free_board(*board);
+        free_list(*movesList);
+        blockRows = newRows;
+        blockCols = newCols;
+    }
+    mode = newMode;
+    *board = generate_empty_board();
+    copy_board(loadedBoard, *board);
+    free_board(loadedBoard);
+    boardHash = board_hash(*board);
+    startingBoard = generate_empty_board();
+    copy_board(*board, startingBoard);
+    *movesList = create_list(startingBoard);
+}
+
+/* runs a parsed command: solve, edit and generate_from start a new game, the rest are executed on the current one */
+void dispatch_command(char* parsedCommand[4], cell*** board, list** movesList, char* command, int counter) {
+    int oldRows = blockRows, oldCols = blockCols;
+    cell** loadedBoard;
+    if (strcmp(parsedCommand[0], "solve") == 0) {
+        loadedBoard = solve_command(parsedCommand, 'S');
+        if (loadedBoard != NULL) { /* solve succeeded */
+            replace_board(loadedBoard, board, movesList, oldRows, oldCols, 'S');
+        }
+    } else if (strcmp(parsedCommand[0], "edit") == 0 || strcmp(parsedCommand[0], "generate_from") == 0) {
+        if (strcmp(parsedCommand[0], "edit") == 0) {
+            loadedBoard = edit_command(parsedCommand, 'E');
+        } else {
+            loadedBoard = generate_from_command(parsedCommand, 'E');
+        }
+        if (loadedBoard != NULL) { /* edit succeeded */
+            replace_board(loadedBoard, board, movesList, oldRows, oldCols, 'E');
+        }
+    } else {
+        execute_command(parsedCommand, *board, command, counter, mode, *movesList);
+    }
+}
@@ -0,0 +1,289 @@
+/** @file generator.c
+ *  @brief generator source file.
+ *
+ *  This module implements the generation of random sudoku grids and puzzles.
+ *  Grids are built directly by a randomized backtracking search over bitmask candidates (see bit_solver),
+ *  so generating a grid needs no external solver.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "generator.h"
+#include "bit_solver.h"
+#include "main_aux.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+
+/* Fills distinct random cells with random legal values, choosing the cells by a partial Fisher-Yates shuffle */
+bool place_random_cells(bitSolver* s, int randomCells) {
+    int cells[MAX_BOARD_CELLS];
+    int i, j, tmp, idx, count = 0;
+    unsigned long mask;
+    for (idx = 0; idx < s->size; idx++) {
+        if (s->grid[idx] == UNASSIGNED) {
+            cells[count] = idx;
+            count++;
+        }
+    }
+    for (i = 0; i < randomCells && i < count; i++) {
+        j = i + prng_below(&s->rng, count - i);
+        tmp = cells[i];
+        cells[i] = cells[j];
+        cells[j] = tmp;
+        mask = bit_candidates(s, cells[i]);
+        if (mask == 0) {
+            return false;
+        }
+        bit_place(s, cells[i], lowest_bit_index(random_bit(&s->rng, mask)) + 1);
+    }
+    return true;
+}
+
+/* Completes the grid in the search context: random cells first, then a randomized and bounded completion search */
+bool complete_random_grid(bitSolver* s, int randomCells) {
+    bool found;
+    if (!place_random_cells(s, randomCells)) {
+        return false;
+    }
+    s->randomOrder = true;
+    s->nodeLimit = (long) GENERATOR_NODES_PER_CELL * s->size;
+    bit_search_begin(s);
+    found = (bit_search_next(s) == SEARCH_FOUND);
+    s->randomOrder = false;
+    s->nodeLimit = 0;
+    return found;
+}
+
+/* Generates a random complete grid: random cells first, then a randomized and bounded completion search */
+bool generate_full_grid(bitSolver* s, int rows, int cols, int randomCells) {
+    return bit_init(s, rows, cols) && complete_random_grid(s, randomCells);
+}
+
+/* Searches for a second solution, which must use another value in one of the removed cells.
+ * removed cell i is tried with every other value while the cells before it hold their solution values */
+bool removal_keeps_unique(bitSolver* s, int* cells, int* values, int count) {
+    int i, val;
+    bool unique = true;
+    unsigned long mask;
+    for (i = 0; i < count && unique; i++) {
+        mask = bit_candidates(s, cells[i]) & ~(1UL << (values[i] - 1));
+        while (mask != 0 && unique) {
+            val = lowest_bit_index(mask) + 1;
+            mask &= mask - 1;
+            bit_place(s, cells[i], val);
+            bit_search_begin(s);
+            unique = (bit_search_next(s) == SEARCH_DONE); /* a check out of nodes keeps the clue */
+            bit_search_end(s);
+            bit_remove(s, cells[i]);
+        }
+        bit_place(s, cells[i], values[i]);
+    }
+    for (i = 0; i < count; i++) {
+        bit_remove(s, cells[i]);
+    }
+    return unique;
+}
+
+/* Digs holes in a random full grid in random (or symmetric) order, undoing removals which break uniqueness */
+int generate_unique(bitSolver* s, int rows, int cols, int targetClues, bool symmetric, int* solution) {
+    int order[MAX_BOARD_CELLS];
+    int cells[2], values[2];
+    int i, j, tmp, count, clues, tries = GENERATOR_TRIES;
+    volatile bool* cancel = s->stop;
+    while (!generate_full_grid(s, rows, cols, 0)) {
+        tries--;
+        if (tries == 0 || (cancel != NULL && *cancel)) {
+            return -1;
+        }
+    }
+    s->stop = cancel; /* bit_init() cleared it, a cancelled uniqueness check fails like an exhausted one */
+    if (solution != NULL) {
+        for (i = 0; i < s->size; i++) {
+            solution[i] = s->grid[i];
+        }
+    }
+    for (i = 0; i < s->size; i++) {
+        order[i] = i;
+    }
+    for (i = 0; i < s->size - 1; i++) { /* Fisher-Yates shuffle of the removal order */
+        j = i + prng_below(&s->rng, s->size - i);
+        tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    clues = s->size;
+    s->nodeLimit = (long) GENERATOR_CHECK_NODES_PER_CELL * s->size;
+    for (i = 0; i < s->size && clues > targetClues && (cancel == NULL || !*cancel); i++) {
+        cells[0] = order[i];
+        count = 1;
+        if (symmetric) { /* every pair is handled once, by its cell in the first half */
+            cells[1] = s->size - 1 - order[i];
+            if (cells[1] < cells[0]) {
+                continue;
+            }
+            if (cells[1] != cells[0]) {
+                count = 2;
+            }
+            if (clues - count < targetClues) {
+                continue;
+            }
+        }
+        for (j = 0; j < count; j++) {
+            values[j] = s->grid[cells[j]];
+            bit_remove(s, cells[j]);
+        }
+        if (removal_keeps_unique(s, cells, values, count)) {
+            clues -= count;
+        } else {
+            for (j = 0; j < count; j++) {
+                bit_place(s, cells[j], values[j]);
+            }
+        }
+    }
+    s->nodeLimit = 0;
+    return (cancel != NULL && *cancel) ? -1 : clues;
+}
+
+/* Fills perm with a random permutation of 0..size-1 (Fisher-Yates), shifted by offset */
+void random_permutation(prng* r, int* perm, int size, int offset) {
+    int i, j, tmp;
+    for (i = 0; i < size; i++) {
+        perm[i] = i + offset;
+    }
+    for (i = size - 1; i > 0; i--) {
+        j = prng_below(r, i + 1);
+        tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+}
+
+/* Builds a random line map of N lines split into groups of groupSize lines:
+ * the groups are permuted and so are the lines within every group */
+void random_line_map(prng* r, int* map, int N, int groupSize) {
+    int groups[MAX_BOARD_SIZE];
+    int inGroup[MAX_BOARD_SIZE];
+    int g, k;
+    random_permutation(r, groups, N / groupSize, 0);
+    for (g = 0; g < N / groupSize; g++) {
+        random_permutation(r, inGroup, groupSize, 0);
+        for (k = 0; k < groupSize; k++) {
+            map[g * groupSize + k] = groups[g] * groupSize + inGroup[k];
+        }
+    }
+}
+
+/* Relabels the digits and moves every cell according to random row and column maps, transposing square blocks at random */
+void transform_grid(prng* r, int* grid, int rows, int cols) {
+    int source[MAX_BOARD_CELLS];
+    int label[MAX_BOARD_SIZE + 1];
+    int rowMap[MAX_BOARD_SIZE], colMap[MAX_BOARD_SIZE];
+    int i, j, N = rows * cols;
+    bool transpose;
+    random_permutation(r, label + 1, N, 1);
+    label[UNASSIGNED] = UNASSIGNED;
+    random_line_map(r, rowMap, N, rows); /* a band is a group of rows sharing blocks */
+    random_line_map(r, colMap, N, cols); /* a stack is a group of columns sharing blocks */
+    transpose = (rows == cols) && prng_below(r, 2) == 1;
+    for (i = 0; i < N * N; i++) {
+        source[i] = grid[i];
+    }
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            if (transpose) {
+                grid[j * N + i] = label[source[rowMap[i] * N + colMap[j]]];
+            } else {
+                grid[i * N + j] = label[source[rowMap[i] * N + colMap[j]]];
+            }
+        }
+    }
+}
+
+/* Speculative generation worker: claims attempts in order until an attempt below the next one succeeded.
+ * attempt k always uses the same seed, and the lowest successful attempt wins, so the result does not depend on timing.
+ * a success stops the workers busy with higher attempts */
+void* speculative_worker(void* arg) {
+    speculativeWorker* worker = (speculativeWorker*) arg;
+    speculativeGeneration* g = worker->generation;
+    bitSolver* s;
+    int i;
+    s = malloc(sizeof(bitSolver));
+    if (s == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    while (true) {
+        pthread_mutex_lock(&g->lock);
+        if (g->nextAttempt >= g->best || (g->cancel != NULL && *g->cancel)) {
+            pthread_mutex_unlock(&g->lock);
+            break;
+        }
+        worker->attempt = g->nextAttempt;
+        worker->stop = false;
+        g->nextAttempt++;
+        pthread_mutex_unlock(&g->lock);
+        bit_init(s, g->rows, g->cols);
+        prng_seed(&s->rng, g->seed + (unsigned long) worker->attempt * 0x9E3779B9UL);
+        s->stop = &worker->stop;
+        if (complete_random_grid(s, g->randomCells)) {
+            pthread_mutex_lock(&g->lock);
+            if (worker->attempt < g->best) {
+                g->best = worker->attempt;
+                s->stop = NULL;
+                *g->result = *s;
+                for (i = 0; i < g->threads; i++) {
+                    if (g->workers[i].attempt > g->best) {
+                        g->workers[i].stop = true;
+                    }
+                }
+            }
+            pthread_mutex_unlock(&g->lock);
+        }
+    }
+    free(s);
+    return NULL;
+}
+
+/* Runs the speculative workers, the calling thread runs the first of them */
+bool generate_full_grid_speculative(bitSolver* s, int rows, int cols, int randomCells, int tries, int threads) {
+    speculativeGeneration g;
+    int i;
+    if (threads < 1) {
+        threads = 1;
+    }
+    g.rows = rows;
+    g.cols = cols;
+    g.randomCells = randomCells;
+    g.nextAttempt = 0;
+    g.best = tries;
+    g.seed = prng_next(&s->rng);
+    g.result = s;
+    g.cancel = s->stop;
+    g.threads = threads;
+    g.workers = malloc(threads * sizeof(speculativeWorker));
+    if (g.workers == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    pthread_mutex_init(&g.lock, NULL);
+    for (i = 0; i < threads; i++) {
+        g.workers[i].generation = &g;
+        g.workers[i].attempt = -1;
+        g.workers[i].stop = false;
+    }
+    for (i = 1; i < threads; i++) {
+        pthread_create(&g.workers[i].thread, NULL, speculative_worker, &g.workers[i]);
+    }
+    speculative_worker(&g.workers[0]);
+    for (i = 1; i < threads; i++) {
+        pthread_join(g.workers[i].thread, NULL);
+    }
+    pthread_mutex_destroy(&g.lock);
+    free(g.workers);
+    return g.best < tries;
+}
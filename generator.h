@@ -0,0 +1,163 @@
+/** @file generator.h
+ *  @brief generator header file.
+ *
+ *  This header contains the prototypes for the generator module.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_GENERATOR_H
+#define SUDOKU_GENERATOR_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include "bit_solver.h"
+#include <pthread.h>
+
+
+/* -- Defines -- */
+#define GENERATOR_NODES_PER_CELL 20 /* search nodes allowed per cell before an attempt is restarted */
+#define GENERATOR_CHECK_NODES_PER_CELL 200 /* search nodes allowed per cell for a single uniqueness check */
+#define GENERATOR_TRIES 1000 /* grid generation attempts before giving up */
+
+
+/* -- Structs -- */
+
+struct speculativeGeneration;
+
+/**
+ * @brief speculativeWorker structure representing a worker thread of a speculative grid generation.
+ * speculativeWorker contains generation field pointing to the shared state and thread field containing the thread id.
+ * speculativeWorker contains attempt field containing the attempt it works on (-1 before the first)
+ * and stop field, the stop flag of its search.
+ *
+ */
+typedef struct speculativeWorker {
+    struct speculativeGeneration* generation;
+    pthread_t thread;
+    int attempt;
+    volatile bool stop;
+} speculativeWorker;
+
+
+/**
+ * @brief speculativeGeneration structure representing the state shared by the workers of a speculative grid generation.
+ * speculativeGeneration contains rows, cols and randomCells fields, the parameters of every attempt,
+ * and seed field, attempt k is seeded with seed and k.
+ * speculativeGeneration contains nextAttempt field containing the next attempt to claim,
+ * and best field containing the lowest successful attempt (the amount of tries while none succeeded).
+ * speculativeGeneration contains result field pointing to the search context receiving the best grid,
+ * and cancel field, the stop flag of that context when it was set (no attempts are claimed once it is set).
+ * speculativeGeneration contains workers and threads fields, the workers and their amount.
+ * speculativeGeneration contains lock field protecting all of the above and the workers attempt and stop fields,
+ * only the searches read their stop flag without it.
+ *
+ */
+typedef struct speculativeGeneration {
+    int rows;
+    int cols;
+    int randomCells;
+    unsigned long seed;
+    int nextAttempt;
+    int best;
+    bitSolver* result;
+    volatile bool* cancel;
+    speculativeWorker* workers;
+    int threads;
+    pthread_mutex_t lock;
+} speculativeGeneration;
+
+
+/** @brief Places random legal values in given amount of distinct random cells of given search context.
+ *  @param s search context.
+ *  @param randomCells amount of empty cells to fill.
+ *  @return true if all cells were filled, false if a chosen cell had no legal value.
+ */
+bool place_random_cells(bitSolver* s, int randomCells);
+
+
+/** @brief Generates a random complete valid grid in given search context.
+ *  first fills randomCells random cells with random legal values,
+ *  then completes the grid with a backtracking search trying candidates in random order.
+ *  the search is bounded by GENERATOR_NODES_PER_CELL nodes per cell, so a bad attempt fails fast and can be retried.
+ *  @param s search context, the grid holds the generated grid on success.
+ *  @param rows block rows.
+ *  @param cols block columns.
+ *  @param randomCells amount of cells to fill randomly before the search.
+ *  @return true if a grid was generated, else false.
+ */
+bool generate_full_grid(bitSolver* s, int rows, int cols, int randomCells);
+
+
+/** @brief Completes the grid of given search context like generate_full_grid(), without initializing it first.
+ *  @param s search context, the grid holds the generated grid on success.
+ *  @param randomCells amount of empty cells to fill randomly before the search.
+ *  @return true if a grid was generated, else false.
+ */
+bool complete_random_grid(bitSolver* s, int randomCells);
+
+
+/** @brief Generates a random complete valid grid by running independently seeded attempts on several threads.
+ *  attempts are numbered and seeded by their number, and the lowest successful attempt wins,
+ *  so the grid depends only on the generator of given search context and not on the amount of threads or timing.
+ *  a success stops the searches of higher attempts, which cuts the latency tail of attempts which backtrack heavily.
+ *  @param s search context, the grid holds the generated grid on success.
+ *  its stop field, when not NULL, cancels the generation once set.
+ *  @param rows block rows.
+ *  @param cols block columns.
+ *  @param randomCells amount of cells to fill randomly before every search.
+ *  @param tries total amount of attempts of all the threads.
+ *  @param threads amount of threads, including the calling thread.
+ *  @return true if a grid was generated, else false.
+ */
+bool generate_full_grid_speculative(bitSolver* s, int rows, int cols, int randomCells, int tries, int threads);
+
+
+/** @brief Checks whether the puzzle in given search context still has a unique solution after some clues were removed.
+ *  the puzzle had a unique solution before the removal, so a second solution must differ from it in a removed cell.
+ *  the check therefore only searches for a solution using another value in one of the removed cells,
+ *  instead of counting the solutions of the whole puzzle again.
+ *  a search stopped by the nodeLimit of the context counts as a second solution, so the result is never wrongly unique.
+ *  @param s search context holding the puzzle after the removal, remains unchanged.
+ *  @param cells indexes of the removed cells.
+ *  @param values the values removed from the cells, which are the unique solution values.
+ *  @param count amount of removed cells.
+ *  @return true if the solution is still unique, else false.
+ */
+bool removal_keeps_unique(bitSolver* s, int* cells, int* values, int count);
+
+
+/** @brief Generates a random puzzle with a unique solution in given search context by digging holes in a full grid.
+ *  clues are removed in random order, or in pairs symmetric around the board center,
+ *  and a removal is undone when the solution stops being unique.
+ *  the digging stops when the puzzle has targetClues clues or no clue can be removed (the puzzle is minimal).
+ *  every uniqueness check is bounded by GENERATOR_CHECK_NODES_PER_CELL nodes per cell,
+ *  a clue whose check runs out of nodes is kept, so on very large boards the puzzle may not be strictly minimal.
+ *  @param s search context, the grid holds the generated puzzle on success.
+ *  its stop field, when not NULL, cancels the generation once set.
+ *  @param rows block rows.
+ *  @param cols block columns.
+ *  @param targetClues clues to stop at, 0 to dig until the puzzle is minimal.
+ *  @param symmetric true to keep the clues rotationally symmetric.
+ *  @param solution array of size cells to be updated with the solution, may be NULL.
+ *  @return amount of clues of the puzzle, -1 if no full grid could be generated or the generation was cancelled.
+ */
+int generate_unique(bitSolver* s, int rows, int cols, int targetClues, bool symmetric, int* solution);
+
+
+/** @brief Applies a random validity preserving transform to given grid, in O(N^2).
+ *  the transform relabels the digits, permutes the bands and the rows within every band,
+ *  permutes the stacks and the columns within every stack, and transposes the grid when the blocks are square.
+ *  empty cells stay empty, so a puzzle is turned into an equally hard puzzle with the same amount of solutions.
+ *  @param r generator.
+ *  @param grid cell values in row-major order, UNASSIGNED for an empty cell, to be updated.
+ *  @param rows block rows.
+ *  @param cols block columns, rows * cols must not exceed MAX_BOARD_SIZE.
+ *  @return void.
+ */
+void transform_grid(prng* r, int* grid, int rows, int cols);
+
+
+#endif /*SUDOKU_GENERATOR_H*/
@@ -0,0 +1,469 @@
+/** @file grader.c
+ *  @brief grader source file.
+ *
+ *  This module implements a logical sudoku solver which applies human solving techniques in increasing cost order,
+ *  and grades the difficulty of a puzzle by the techniques it needed.
+ *  Every step restarts from the cheapest technique, so an expensive technique is only counted when nothing cheaper applies.
+ *  The subset techniques (naked and hidden pairs and triples) and the fish techniques (X-wing and swordfish)
+ *  share a single search for k bitmasks whose union holds exactly k bits.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "grader.h"
+#include "bit_solver.h"
+#include "main_aux.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* -- Defines -- */
+#define STEP_NONE 0
+#define STEP_PROGRESS 1
+#define STEP_CONTRADICTION (-1)
+
+
+/* -- Global Variables  -- */
+const char* techniqueNames[TECHNIQUES] = {"naked single", "hidden single", "locked candidates", "naked pair",
+                                          "hidden pair", "naked triple", "hidden triple", "x-wing", "swordfish"};
+const long techniqueWeights[TECHNIQUES] = {1, 2, 10, 15, 20, 30, 40, 60, 100};
+
+
+/* Loads the puzzle and builds the units table: a row lists its cells by column, a column by row, a box row by row */
+void grader_load(grader* g, bitSolver* s) {
+    int idx, row, col, box;
+    g->N = s->N;
+    g->size = s->size;
+    g->fullMask = s->fullMask;
+    g->empty = 0;
+    for (idx = 0; idx < s->size; idx++) {
+        row = s->rowOf[idx];
+        col = s->colOf[idx];
+        box = s->boxOf[idx];
+        g->units[row][col] = idx;
+        g->units[g->N + col][row] = idx;
+        g->units[2 * g->N + box][(row % s->blockRows) * s->blockCols + col % s->blockCols] = idx;
+        g->unitsOf[idx][0] = row;
+        g->unitsOf[idx][1] = g->N + col;
+        g->unitsOf[idx][2] = 2 * g->N + box;
+        g->grid[idx] = s->grid[idx];
+        g->cand[idx] = (s->grid[idx] == UNASSIGNED) ? bit_candidates(s, idx) : 0;
+        if (s->grid[idx] == UNASSIGNED) {
+            g->empty++;
+        }
+    }
+}
+
+/* Places a value and removes it from the candidates of the cell's units */
+void grader_place(grader* g, int idx, int val) {
+    unsigned long bit = 1UL << (val - 1);
+    int k, p;
+    g->grid[idx] = val;
+    g->cand[idx] = 0;
+    g->empty--;
+    for (k = 0; k < 3; k++) {
+        for (p = 0; p < g->N; p++) {
+            g->cand[g->units[g->unitsOf[idx][k]][p]] &= ~bit;
+        }
+    }
+}
+
+/* Removes candidates from a cell, returns true if any of them was there */
+bool eliminate(grader* g, int idx, unsigned long mask) {
+    if ((g->cand[idx] & mask) == 0) {
+        return false;
+    }
+    g->cand[idx] &= ~mask;
+    return true;
+}
+
+/* Advances the k chosen indexes to the next combination of 0..n-1 in lexicographic order, false after the last one */
+bool next_combination(int* chosen, int k, int n) {
+    int i = k - 1;
+    while (i >= 0 && chosen[i] == n - k + i) {
+        i--;
+    }
+    if (i < 0) {
+        return false;
+    }
+    chosen[i]++;
+    for (i++; i < k; i++) {
+        chosen[i] = chosen[i - 1] + 1;
+    }
+    return true;
+}
+
+/* Fills list with the indexes of the masks holding 1 to k bits, returns their amount */
+int subset_candidates(unsigned long* masks, int n, int k, int* list) {
+    int i, bits, count = 0;
+    for (i = 0; i < n; i++) {
+        bits = count_bits(masks[i]);
+        if (bits >= 1 && bits <= k) {
+            list[count] = i;
+            count++;
+        }
+    }
+    return count;
+}
+
+/* Looks for k of the listed masks whose union holds exactly k bits, continuing from the combination in chosen
+ * (or from the first one when start is true). returns the union, 0 if there is none.
+ * chosenMask is updated with the bits of the chosen indexes */
+unsigned long find_subset(unsigned long* masks, int* list, int count, int k, int* chosen, bool start,
+                          unsigned long* chosenMask) {
+    int i;
+    unsigned long unionMask;
+    if (count < k) {
+        return 0;
+    }
+    if (start) {
+        for (i = 0; i < k; i++) {
+            chosen[i] = i;
+        }
+    } else if (!next_combination(chosen, k, count)) {
+        return 0;
+    }
+    do {
+        unionMask = 0;
+        *chosenMask = 0;
+        for (i = 0; i < k; i++) {
+            unionMask |= masks[list[chosen[i]]];
+            *chosenMask |= 1UL << list[chosen[i]];
+        }
+        if (count_bits(unionMask) == k) {
+            return unionMask;
+        }
+    } while (next_combination(chosen, k, count));
+    return 0;
+}
+
+/* Naked single: an empty cell with a single candidate */
+int naked_single(grader* g) {
+    int idx;
+    for (idx = 0; idx < g->size; idx++) {
+        if (g->grid[idx] == UNASSIGNED) {
+            if (g->cand[idx] == 0) {
+                return STEP_CONTRADICTION;
+            }
+            if ((g->cand[idx] & (g->cand[idx] - 1)) == 0) {
+                grader_place(g, idx, lowest_bit_index(g->cand[idx]) + 1);
+                return STEP_PROGRESS;
+            }
+        }
+    }
+    return STEP_NONE;
+}
+
+/* Hidden single: a unit value with a single possible cell */
+int hidden_single(grader* g) {
+    int u, p, idx;
+    unsigned long placed, once, twice, hidden;
+    for (u = 0; u < 3 * g->N; u++) {
+        placed = 0;
+        once = 0;
+        twice = 0;
+        for (p = 0; p < g->N; p++) {
+            idx = g->units[u][p];
+            if (g->grid[idx] != UNASSIGNED) {
+                placed |= 1UL << (g->grid[idx] - 1);
+            }
+            twice |= once & g->cand[idx];
+            once |= g->cand[idx];
+        }
+        if ((g->fullMask & ~placed & ~once) != 0) {
+            return STEP_CONTRADICTION;
+        }
+        hidden = once & ~twice;
+        if (hidden != 0) {
+            hidden &= ~hidden + 1;
+            for (p = 0; p < g->N; p++) {
+                if (g->cand[g->units[u][p]] & hidden) {
+                    grader_place(g, g->units[u][p], lowest_bit_index(hidden) + 1);
+                    return STEP_PROGRESS;
+                }
+            }
+        }
+    }
+    return STEP_NONE;
+}
+
+/* Locked candidates: when the cells of a unit holding a value all share another unit,
+ * the value is removed from the rest of that unit (pointing from a box, claiming from a row or column) */
+int locked_candidates(grader* g) {
+    int u, p, k, v, first, count, shared;
+    bool progress;
+    unsigned long bit;
+    for (u = 0; u < 3 * g->N; u++) {
+        for (v = 0; v < g->N; v++) {
+            bit = 1UL << v;
+            first = -1;
+            count = 0;
+            for (p = 0; p < g->N; p++) {
+                if (g->cand[g->units[u][p]] & bit) {
+                    if (first < 0) {
+                        first = g->units[u][p];
+                    }
+                    count++;
+                }
+            }
+            if (count < 2) {
+                continue;
+            }
+            for (k = 0; k < 3; k++) {
+                shared = g->unitsOf[first][k];
+                if (shared == u) {
+                    continue;
+                }
+                for (p = 0; p < g->N; p++) { /* every cell of u holding the value must be in the shared unit */
+                    if ((g->cand[g->units[u][p]] & bit) && g->unitsOf[g->units[u][p]][k] != shared) {
+                        break;
+                    }
+                }
+                if (p < g->N) {
+                    continue;
+                }
+                progress = false;
+                for (p = 0; p < g->N; p++) {
+                    if (g->unitsOf[g->units[shared][p]][u / g->N] != u) {
+                        progress |= eliminate(g, g->units[shared][p], bit);
+                    }
+                }
+                if (progress) {
+                    return STEP_PROGRESS;
+                }
+            }
+        }
+    }
+    return STEP_NONE;
+}
+
+/* Naked subset: k cells of a unit holding only k candidates together, which are removed from the other cells */
+int naked_subset(grader* g, int k) {
+    int u, p, count;
+    int list[MAX_BOARD_SIZE], chosen[3];
+    unsigned long masks[MAX_BOARD_SIZE];
+    unsigned long unionMask, chosenMask;
+    bool progress, start;
+    for (u = 0; u < 3 * g->N; u++) {
+        for (p = 0; p < g->N; p++) {
+            masks[p] = g->cand[g->units[u][p]];
+        }
+        count = subset_candidates(masks, g->N, k, list);
+        start = true;
+        while ((unionMask = find_subset(masks, list, count, k, chosen, start, &chosenMask)) != 0) {
+            start = false;
+            progress = false;
+            for (p = 0; p < g->N; p++) {
+                if ((chosenMask & (1UL << p)) == 0) {
+                    progress |= eliminate(g, g->units[u][p], unionMask);
+                }
+            }
+            if (progress) {
+                return STEP_PROGRESS;
+            }
+        }
+    }
+    return STEP_NONE;
+}
+
+/* Hidden subset: k values of a unit possible in only k cells together, which lose their other candidates */
+int hidden_subset(grader* g, int k) {
+    int u, p, v, count;
+    int list[MAX_BOARD_SIZE], chosen[3];
+    unsigned long positions[MAX_BOARD_SIZE];
+    unsigned long unionMask, valuesMask;
+    bool progress, start;
+    for (u = 0; u < 3 * g->N; u++) {
+        for (v = 0; v < g->N; v++) {
+            positions[v] = 0;
+            for (p = 0; p < g->N; p++) {
+                if (g->cand[g->units[u][p]] & (1UL << v)) {
+                    positions[v] |= 1UL << p;
+                }
+            }
+        }
+        count = subset_candidates(positions, g->N, k, list);
+        start = true;
+        while ((unionMask = find_subset(positions, list, count, k, chosen, start, &valuesMask)) != 0) {
+            start = false;
+            progress = false;
+            for (p = 0; p < g->N; p++) {
+                if (unionMask & (1UL << p)) {
+                    progress |= eliminate(g, g->units[u][p], ~valuesMask);
+                }
+            }
+            if (progress) {
+                return STEP_PROGRESS;
+            }
+        }
+    }
+    return STEP_NONE;
+}
+
+/* Fish of size k (X-wing, swordfish): k rows (or columns) holding a value only in k columns (or rows) together,
+ * so the value is removed from the other cells of these columns (or rows) */
+int fish(grader* g, int k) {
+    int type, v, line, p, count;
+    int list[MAX_BOARD_SIZE], chosen[3];
+    unsigned long positions[MAX_BOARD_SIZE];
+    unsigned long bit, coverMask, baseMask;
+    bool progress, start;
+    for (type = 0; type < 2; type++) { /* base lines are rows, then columns */
+        for (v = 0; v < g->N; v++) {
+            bit = 1UL << v;
+            for (line = 0; line < g->N; line++) {
+                positions[line] = 0;
+                for (p = 0; p < g->N; p++) {
+                    if (g->cand[g->units[type * g->N + line][p]] & bit) {
+                        positions[line] |= 1UL << p;
+                    }
+                }
+            }
+            count = subset_candidates(positions, g->N, k, list);
+            start = true;
+            while ((coverMask = find_subset(positions, list, count, k, chosen, start, &baseMask)) != 0) {
+                start = false;
+                progress = false;
+                for (line = 0; line < g->N; line++) {
+                    if ((coverMask & (1UL << line)) == 0) {
+                        continue;
+                    }
+                    for (p = 0; p < g->N; p++) { /* position p of a cover line is base line p */
+                        if ((baseMask & (1UL << p)) == 0) {
+                            progress |= eliminate(g, g->units[(1 - type) * g->N + line][p], bit);
+                        }
+                    }
+                }
+                if (progress) {
+                    return STEP_PROGRESS;
+                }
+            }
+        }
+    }
+    return STEP_NONE;
+}
+
+/* Applies the techniques in increasing cost order until one makes progress */
+int grader_step(grader* g) {
+    int technique, status = STEP_NONE;
+    for (technique = 0; technique < TECHNIQUES && status == STEP_NONE; technique++) {
+        switch (technique) {
+            case TECHNIQUE_NAKED_SINGLE:
+                status = naked_single(g);
+                break;
+            case TECHNIQUE_HIDDEN_SINGLE:
+                status = hidden_single(g);
+                break;
+            case TECHNIQUE_LOCKED_CANDIDATES:
+                status = locked_candidates(g);
+                break;
+            case TECHNIQUE_NAKED_PAIR:
+                status = naked_subset(g, 2);
+                break;
+            case TECHNIQUE_HIDDEN_PAIR:
+                status = hidden_subset(g, 2);
+                break;
+            case TECHNIQUE_NAKED_TRIPLE:
+                status = naked_subset(g, 3);
+                break;
+            case TECHNIQUE_HIDDEN_TRIPLE:
+                status = hidden_subset(g, 3);
+                break;
+            case TECHNIQUE_X_WING:
+                status = fish(g, 2);
+                break;
+            default:
+                status = fish(g, 3);
+                break;
+        }
+    }
+    if (status == STEP_CONTRADICTION) {
+        return GRADE_CONTRADICTION;
+    }
+    return (status == STEP_PROGRESS) ? technique - 1 : GRADE_STUCK;
+}
+
+/* Solves the puzzle with logical steps only, counting the steps of every technique */
+void grade_puzzle(bitSolver* s, gradeResult* result) {
+    grader* g;
+    int technique;
+    g = malloc(sizeof(grader));
+    if (g == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    grader_load(g, s);
+    for (technique = 0; technique < TECHNIQUES; technique++) {
+        result->steps[technique] = 0;
+    }
+    result->hardest = -1;
+    result->score = 0;
+    technique = 0;
+    while (g->empty > 0 && (technique = grader_step(g)) >= 0) {
+        result->steps[technique]++;
+        result->score += techniqueWeights[technique];
+        if (technique > result->hardest) {
+            result->hardest = technique;
+        }
+    }
+    result->solved = (g->empty == 0);
+    result->contradiction = (technique == GRADE_CONTRADICTION);
+    result->left = g->empty;
+    free(g);
+}
+
+/* Solves the puzzle with logical steps only, recording the step which filled the given cell */
+int deduce_cell(bitSolver* s, int idx, int* technique, long* steps, int* solution) {
+    grader* g;
+    int step = 0, value, i;
+    long made = 0;
+    g = malloc(sizeof(grader));
+    if (g == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    grader_load(g, s);
+    *technique = GRADE_STUCK;
+    while (g->empty > 0 && (step = grader_step(g)) >= 0) {
+        if (*technique == GRADE_STUCK && g->grid[idx] != UNASSIGNED) {
+            *technique = step;
+            *steps = made;
+        }
+        made++;
+    }
+    value = (step == GRADE_CONTRADICTION) ? GRADE_CONTRADICTION : ((g->empty > 0) ? GRADE_STUCK : g->grid[idx]);
+    if (value > 0 && solution != NULL) {
+        for (i = 0; i < g->size; i++) {
+            solution[i] = g->grid[i];
+        }
+    }
+    free(g);
+    return value;
+}
+
+/* Returns the name of the technique */
+const char* technique_name(int technique) {
+    return techniqueNames[technique];
+}
+
+/* Returns the difficulty level by the most expensive technique needed */
+const char* grade_level(gradeResult* result) {
+    if (result->contradiction) {
+        return "unsolvable";
+    }
+    if (!result->solved) {
+        return "extreme";
+    }
+    if (result->hardest <= TECHNIQUE_HIDDEN_SINGLE) {
+        return "easy";
+    }
+    if (result->hardest <= TECHNIQUE_HIDDEN_PAIR) {
+        return "medium";
+    }
+    if (result->hardest <= TECHNIQUE_HIDDEN_TRIPLE) {
+        return "hard";
+    }
+    return "expert";
+}
@@ -0,0 +1,131 @@
+/** @file grader.h
+ *  @brief grader header file.
+ *
+ *  This header contains the prototypes for the grader module.
+ *  contains the structure definitions of the logical solver state and of a difficulty grade.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_GRADER_H
+#define SUDOKU_GRADER_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include "bit_solver.h"
+
+
+/* -- Defines -- */
+#define TECHNIQUE_NAKED_SINGLE 0
+#define TECHNIQUE_HIDDEN_SINGLE 1
+#define TECHNIQUE_LOCKED_CANDIDATES 2
+#define TECHNIQUE_NAKED_PAIR 3
+#define TECHNIQUE_HIDDEN_PAIR 4
+#define TECHNIQUE_NAKED_TRIPLE 5
+#define TECHNIQUE_HIDDEN_TRIPLE 6
+#define TECHNIQUE_X_WING 7
+#define TECHNIQUE_SWORDFISH 8
+#define TECHNIQUES 9
+
+#define GRADE_STUCK (-1) /* no technique applies */
+#define GRADE_CONTRADICTION (-2) /* a cell or a unit value has no candidate left */
+
+#define GRADE_UNITS (3 * MAX_BOARD_SIZE)
+
+
+/* -- Structs -- */
+
+/**
+ * @brief grader structure representing the state of a logical (human style) solver.
+ * grader contains N, size and fullMask fields like the search context it was loaded from.
+ * grader contains grid field containing the cell values and cand field the candidates bitmask of every empty cell.
+ * grader contains units field listing the cells of every row, column and box, and unitsOf the units of every cell.
+ * grader contains empty field containing the amount of empty cells.
+ *
+ */
+typedef struct grader {
+    int N;
+    int size;
+    unsigned long fullMask;
+    int grid[MAX_BOARD_CELLS];
+    unsigned long cand[MAX_BOARD_CELLS];
+    int units[GRADE_UNITS][MAX_BOARD_SIZE];
+    int unitsOf[MAX_BOARD_CELLS][3];
+    int empty;
+} grader;
+
+
+/**
+ * @brief gradeResult structure representing the difficulty grade of a puzzle.
+ * gradeResult contains steps field counting the steps made by every technique.
+ * gradeResult contains hardest field containing the most expensive technique needed, -1 if none.
+ * gradeResult contains solved field, false if logic got stuck (the puzzle needs guessing) or found a contradiction,
+ * contradiction field, true if the puzzle has no solution, and left field containing the amount of cells not filled.
+ * gradeResult contains score field, the sum of the steps weighted by the technique cost.
+ *
+ */
+typedef struct gradeResult {
+    long steps[TECHNIQUES];
+    int hardest;
+    bool solved;
+    bool contradiction;
+    int left;
+    long score;
+} gradeResult;
+
+
+/** @brief Loads the puzzle of given search context into given grader, computing the candidates of every empty cell.
+ *  @param g grader to initialize.
+ *  @param s search context holding the puzzle, remains unchanged.
+ *  @return void.
+ */
+void grader_load(grader* g, bitSolver* s);
+
+
+/** @brief Makes a single logical step using the cheapest technique which makes progress,
+ *  a step either fills a cell or removes candidates.
+ *  @param g grader.
+ *  @return the technique used, GRADE_STUCK if none applies or GRADE_CONTRADICTION if the puzzle has no solution.
+ */
+int grader_step(grader* g);
+
+
+/** @brief Grades the puzzle of given search context by solving it with logical steps only.
+ *  @param s search context holding the puzzle, remains unchanged.
+ *  @param result to be updated with the grade.
+ *  @return void.
+ */
+void grade_puzzle(bitSolver* s, gradeResult* result);
+
+
+/** @brief Deduces the value of an empty cell by solving the puzzle with logical steps only.
+ *  the value is only returned when logic solves the whole puzzle, which also proves the puzzle is solvable.
+ *  @param s search context holding the puzzle, remains unchanged.
+ *  @param idx cell index in row-major order.
+ *  @param technique to be updated with the technique which filled the cell.
+ *  @param steps to be updated with the amount of logical steps made before the cell was filled.
+ *  @param solution to be updated with the solution values in row-major order when logic solves the puzzle, or NULL.
+ *  @return the cell value, GRADE_STUCK if logic cannot solve the puzzle
+ *  or GRADE_CONTRADICTION if the puzzle has no solution.
+ */
+int deduce_cell(bitSolver* s, int idx, int* technique, long* steps, int* solution);
+
+
+/** @brief Returns the name of given technique.
+ *  @param technique technique number.
+ *  @return technique name.
+ */
+const char* technique_name(int technique);
+
+
+/** @brief Returns the difficulty level of given grade: easy, medium, hard, expert, extreme (needs guessing)
+ *  or unsolvable.
+ *  @param result grade.
+ *  @return level name.
+ */
+const char* grade_level(gradeResult* result);
+
+
+#endif /*SUDOKU_GRADER_H*/
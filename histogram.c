@@ -0,0 +1,97 @@
+/** @file histogram.c
+ *  @brief histogram source file.
+ *
+ *  This module implements a log-linear bucketed histogram used to report latency percentiles.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "histogram.h"
+#include <math.h>
+#include <string.h>
+
+
+/* Empties the histogram */
+void histogram_reset(histogram* h) {
+    memset(h->counts, 0, sizeof(h->counts));
+    h->total = 0;
+    h->sum = 0;
+    h->min = 0;
+    h->max = 0;
+}
+
+/* Returns the bucket of given value: the power of two range selects the major bucket,
+ * the position within the range selects the sub bucket */
+int histogram_bucket(double value) {
+    int exponent, bucket;
+    double mantissa;
+    if (value < 1) {
+        return 0;
+    }
+    mantissa = frexp(value, &exponent); /* value = mantissa * 2^exponent, mantissa in [0.5, 1) */
+    bucket = (exponent - 1) * HISTOGRAM_SUB_BUCKETS + (int) ((mantissa - 0.5) * 2 * HISTOGRAM_SUB_BUCKETS);
+    if (bucket >= HISTOGRAM_BUCKETS) {
+        bucket = HISTOGRAM_BUCKETS - 1;
+    }
+    return bucket;
+}
+
+/* Records a value in the histogram */
+void histogram_record(histogram* h, double value) {
+    h->counts[histogram_bucket(value)]++;
+    if (h->total == 0 || value < h->min) {
+        h->min = value;
+    }
+    if (h->total == 0 || value > h->max) {
+        h->max = value;
+    }
+    h->total++;
+    h->sum += value;
+}
+
+/* Adds the source histogram values to the target histogram */
+void histogram_merge(histogram* target, histogram* source) {
+    int i;
+    if (source->total == 0) {
+        return;
+    }
+    for (i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        target->counts[i] += source->counts[i];
+    }
+    if (target->total == 0 || source->min < target->min) {
+        target->min = source->min;
+    }
+    if (target->total == 0 || source->max > target->max) {
+        target->max = source->max;
+    }
+    target->total += source->total;
+    target->sum += source->sum;
+}
+
+/* Returns the upper bound of the bucket, the start of the next sub bucket */
+double histogram_bucket_bound(int bucket) {
+    return ldexp(1.0 + (double) (bucket % HISTOGRAM_SUB_BUCKETS + 1) / HISTOGRAM_SUB_BUCKETS,
+                 bucket / HISTOGRAM_SUB_BUCKETS);
+}
+
+/* Returns the upper bound of the bucket containing the given percentile, capped by the maximal value */
+double histogram_percentile(histogram* h, double percent) {
+    int i;
+    unsigned long seen = 0;
+    double rank, bound;
+    if (h->total == 0) {
+        return 0;
+    }
+    rank = h->total * percent / 100.0;
+    for (i = 0; i < HISTOGRAM_BUCKETS - 1; i++) {
+        seen += h->counts[i];
+        if (seen >= rank && seen > 0) {
+            break;
+        }
+    }
+    bound = histogram_bucket_bound(i);
+    return (bound < h->max) ? bound : h->max;
+}
@@ -0,0 +1,79 @@
+/** @file histogram.h
+ *  @brief histogram header file.
+ *
+ *  This header contains the prototypes for the histogram module.
+ *  contains the structure definition of a fixed size latency histogram.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_HISTOGRAM_H
+#define SUDOKU_HISTOGRAM_H
+
+
+/* -- Defines -- */
+#define HISTOGRAM_SUB_BUCKETS 16
+#define HISTOGRAM_MAJOR_BUCKETS 48
+#define HISTOGRAM_BUCKETS (HISTOGRAM_SUB_BUCKETS * HISTOGRAM_MAJOR_BUCKETS)
+
+
+/* -- Structs -- */
+
+/**
+ * @brief histogram structure representing a distribution of recorded values (latencies in nanoseconds).
+ * every power of two range [2^k, 2^(k+1)) is split into HISTOGRAM_SUB_BUCKETS equal buckets,
+ * so percentiles are accurate to about 6% while memory stays constant whatever the amount of values.
+ * histogram contains counts field containing the amount of values recorded per bucket.
+ * histogram contains total, sum, min and max fields summarizing all recorded values.
+ *
+ */
+typedef struct histogram {
+    unsigned long counts[HISTOGRAM_BUCKETS];
+    unsigned long total;
+    double sum;
+    double min;
+    double max;
+} histogram;
+
+
+/** @brief Empties given histogram.
+ *  @param h histogram to reset.
+ *  @return void.
+ */
+void histogram_reset(histogram* h);
+
+
+/** @brief Records a value in given histogram.
+ *  @param h histogram to update.
+ *  @param value non negative value to record.
+ *  @return void.
+ */
+void histogram_record(histogram* h, double value);
+
+
+/** @brief Adds all values recorded in source histogram to target histogram.
+ *  @param target histogram to update.
+ *  @param source histogram, remains unchanged.
+ *  @return void.
+ */
+void histogram_merge(histogram* target, histogram* source);
+
+
+/** @brief Returns the upper bound (exclusive) of the values counted in given bucket.
+ *  @param bucket bucket index, 0 to HISTOGRAM_BUCKETS - 1.
+ *  @return upper bound.
+ */
+double histogram_bucket_bound(int bucket);
+
+
+/** @brief Returns the value below which given percent of the recorded values fall.
+ *  @param h histogram.
+ *  @param percent between 0-100.
+ *  @return percentile value (upper bound of its bucket), 0 if histogram is empty.
+ */
+double histogram_percentile(histogram* h, double percent);
+
+
+#endif /*SUDOKU_HISTOGRAM_H*/
@@ -0,0 +1,108 @@
+/** @file history.c
+ *  @brief history source file.
+ *
+ *  This module keeps the moves made on a board as the list of the cells they changed, for undo and redo.
+ *  A move costs memory for the cells it changed only, and the history knows nothing of how the board is stored,
+ *  so the game moves list and the contexts of libsudoku both keep theirs with it. It uses no global state, prints
+ *  nothing, and reports a failed allocation to its caller.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "history.h"
+#include <stdlib.h>
+
+
+/* Initializes an empty history, its changes are allocated by the first move */
+void history_init(history* h) {
+    h->changes = NULL;
+    h->count = 0;
+    h->position = 0;
+    h->capacity = 0;
+}
+
+/* Frees the changes */
+void history_free(history* h) {
+    free(h->changes);
+    history_init(h);
+}
+
+/* Forgets every change */
+void history_clear(history* h) {
+    h->count = 0;
+    h->position = 0;
+}
+
+/* Drops the undone changes and doubles the capacity until the extra changes fit */
+bool history_reserve(history* h, int extra) {
+    historyChange* changes;
+    int capacity = (h->capacity == 0) ? HISTORY_INITIAL_CAPACITY : h->capacity;
+    h->count = h->position; /* a new move can't be followed by the undone ones */
+    if (h->count + extra <= h->capacity) {
+        return true;
+    }
+    while (capacity < h->count + extra) {
+        capacity *= 2;
+    }
+    changes = realloc(h->changes, capacity * sizeof(historyChange));
+    if (changes == NULL) {
+        return false;
+    }
+    h->changes = changes;
+    h->capacity = capacity;
+    return true;
+}
+
+/* Appends the change, which is applied */
+void history_record(history* h, int idx, int before, int after, int step) {
+    historyChange* change = &h->changes[h->count];
+    change->idx = idx;
+    change->before = before;
+    change->after = after;
+    change->step = step;
+    h->count++;
+    h->position = h->count;
+}
+
+/* Returns the step after the one of the last applied change */
+int history_next_step(const history* h) {
+    return (h->position == 0) ? 1 : h->changes[h->position - 1].step + 1;
+}
+
+/* Moves the position back over the changes sharing the step of the last applied one */
+bool history_undo(history* h, int* first, int* last) {
+    int step;
+    if (h->position == 0) {
+        return false;
+    }
+    *last = h->position;
+    step = h->changes[h->position - 1].step;
+    while (h->position > 0 && h->changes[h->position - 1].step == step) {
+        h->position--;
+    }
+    *first = h->position;
+    return true;
+}
+
+/* Moves the position forward over the changes sharing the step of the first undone one */
+bool history_redo(history* h, int* first, int* last) {
+    int step;
+    if (h->position == h->count) {
+        return false;
+    }
+    *first = h->position;
+    step = h->changes[h->position].step;
+    while (h->position < h->count && h->changes[h->position].step == step) {
+        h->position++;
+    }
+    *last = h->position;
+    return true;
+}
+
+/* Returns the size of the allocated changes */
+long history_bytes(const history* h) {
+    return h->capacity * (long) sizeof(historyChange);
+}
@@ -0,0 +1,127 @@
+/** @file history.h
+ *  @brief history header file.
+ *
+ *  This header contains the prototypes for the move history module.
+ *  contains the structure definitions of a cell change and of the history of the moves of a board.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_HISTORY_H
+#define SUDOKU_HISTORY_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+
+
+/* -- Defines -- */
+#define HISTORY_INITIAL_CAPACITY 64 /* changes held before the history grows for the first time */
+
+
+/* -- Structs -- */
+
+/**
+ * @brief historyChange structure representing the change of one cell by a move.
+ * historyChange contains idx field, the cell index in row-major order, before and after fields, its values before
+ * and after the move, and step field, the number of the move.
+ *
+ */
+typedef struct historyChange {
+    int idx;
+    int before;
+    int after;
+    int step;
+} historyChange;
+
+/**
+ * @brief history structure representing the moves made on a board, as the list of their cell changes,
+ * the changes of one move share its step number.
+ * history contains changes field, count field, the amount of changes in it, position field, the amount of them
+ * applied (the rest can be redone), and capacity field.
+ *
+ */
+typedef struct history {
+    historyChange* changes;
+    int count;
+    int position;
+    int capacity;
+} history;
+
+
+/** @brief Initializes an empty history.
+ *  @param h history to init.
+ *  @return void.
+ */
+void history_init(history* h);
+
+
+/** @brief Frees the changes of a history, which is empty afterwards.
+ *  @param h history to free.
+ *  @return void.
+ */
+void history_free(history* h);
+
+
+/** @brief Removes every move of a history, keeping its memory.
+ *  @param h history to clear.
+ *  @return void.
+ */
+void history_clear(history* h);
+
+
+/** @brief Drops the undone moves, which can't follow a new move, and makes room for more changes.
+ *  @param h history.
+ *  @param extra amount of changes to make room for.
+ *  @return true, or false if memory ran out (the history is unchanged but for the dropped moves).
+ */
+bool history_reserve(history* h, int extra);
+
+
+/** @brief Appends a change of a move to the history, the room was reserved by history_reserve.
+ *  @param h history.
+ *  @param idx index of the changed cell.
+ *  @param before value of the cell before the change.
+ *  @param after value of the cell after the change.
+ *  @param step number of the move, from history_next_step.
+ *  @return void.
+ */
+void history_record(history* h, int idx, int before, int after, int step);
+
+
+/** @brief Returns the number of the next move, the changes recorded with it make one move.
+ *  @param h history.
+ *  @return step number.
+ */
+int history_next_step(const history* h);
+
+
+/** @brief Marks the last applied move as undone.
+ *  the caller restores the before values of its changes, last to first.
+ *  @param h history.
+ *  @param first to be updated with the index of the first change of the move.
+ *  @param last to be updated with the index after the last change of the move.
+ *  @return true, or false if there is no move to undo.
+ */
+bool history_undo(history* h, int* first, int* last);
+
+
+/** @brief Marks the first undone move as applied again.
+ *  the caller restores the after values of its changes, first to last.
+ *  @param h history.
+ *  @param first to be updated with the index of the first change of the move.
+ *  @param last to be updated with the index after the last change of the move.
+ *  @return true, or false if there is no move to redo.
+ */
+bool history_redo(history* h, int* first, int* last);
+
+
+/** @brief Returns the memory held by the changes of a history.
+ *  @param h history.
+ *  @return bytes.
+ */
+long history_bytes(const history* h);
+
+
+#endif /*SUDOKU_HISTORY_H*/
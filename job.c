@@ -0,0 +1,204 @@
+/** @file job.c
+ *  @brief job source file.
+ *
+ *  This module runs long commands (num_solutions, generate) on a worker thread, so the main loop stays responsive
+ *  and the cancel command or Ctrl-C can stop them. The console has one job, which runs one at a time; the server
+ *  selects the job of the session whose command runs, so every session can have a job running. The server commands
+ *  run on a fixed pool of workers, so its jobs are deferred: the worker running the command runs its job as well.
+ *  The work function checks the job stop flag (a search context points its stop field at it),
+ *  and leaves the board untouched when it is stopped. It prints only to the stream of the job and keeps its errors in
+ *  the job; changes to the game state are made by the finish function, which runs on the main loop thread.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Defines -- */
+#define _GNU_SOURCE
+
+/* -- Includes -- */
+#include "job.h"
+#include "main_aux.h"
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+/* -- Global Variables  -- */
+commandJob commandWorker;
+__thread commandJob* currentJob = &commandWorker; /* the job the job functions of the thread act on */
+__thread bool jobsDeferred = false; /* the jobs the thread starts run when it waits for them */
+int jobNotifyFd = -1; /* descriptor the jobs write their address to when they finish, -1 for none */
+struct sigaction previousInterrupt; /* SIGINT action restored when the job ends */
+
+
+/* SIGINT handler while a job runs: stops the job instead of the game */
+void interrupt_job(int signum) {
+    (void) signum;
+    commandWorker.stop = true;
+}
+
+/* Thread entry: runs the work function, marks the job finished and notifies the main loop if it asked to */
+void* job_thread(void* arg) {
+    commandJob* job = (commandJob*) arg;
+    commandOutput = job->out; /* a failed allocation prints there */
+    job->work(job);
+    pthread_mutex_lock(&job->lock);
+    job->finished = true;
+    pthread_mutex_unlock(&job->lock);
+    if (job->notifyFd >= 0) {
+        while (write(job->notifyFd, &job, sizeof(job)) < 0 && errno == EINTR); /* a pipe write this small is atomic */
+    }
+    return NULL;
+}
+
+/* Joins the finished thread, runs the finish function printing to the job stream, passes a failure of the job to the
+ * current command, then frees the job search context and restores the SIGINT action */
+void job_join() {
+    FILE* output = commandOutput;
+    commandJob* job = currentJob;
+    if (!job->deferred) {
+        pthread_join(job->thread, NULL);
+    }
+    pthread_mutex_destroy(&job->lock);
+    if (job->failed) {
+        commandFailed = true;
+        strcpy(lastError, job->error);
+    }
+    if (job->finish != NULL) {
+        commandOutput = job->out;
+        job->finish(job);
+        commandOutput = output;
+    }
+    free(job->s);
+    job->s = NULL;
+    if (!job->deferred) {
+        sigaction(SIGINT, &previousInterrupt, NULL);
+    }
+    job->running = false;
+}
+
+/* Selects the job the other functions act on */
+void job_select(commandJob* job) {
+    currentJob = (job != NULL) ? job : &commandWorker;
+}
+
+/* Sets the descriptor the jobs started afterwards notify */
+void job_notify(int fd) {
+    jobNotifyFd = fd;
+}
+
+/* Sets whether the jobs the thread starts afterwards are deferred */
+void job_defer(bool defer) {
+    jobsDeferred = defer;
+}
+
+/* Starts the worker thread, or leaves a deferred job to job_wait. a console job catches SIGINT with SA_RESTART,
+ * so a blocked read of the next command goes on */
+void job_start(void (*work)(commandJob*), void (*finish)(commandJob*), cell** board, list* lst, bitSolver* s,
+               long args[3], const char* path) {
+    struct sigaction action;
+    commandJob* job = currentJob;
+    job->work = work;
+    job->finish = finish;
+    job->out = commandOutput;
+    job->failed = false;
+    job->finished = false;
+    job->deferred = jobsDeferred;
+    if (!job->deferred) {
+        job->stop = false;
+    }
+    job->board = board;
+    job->lst = lst;
+    job->s = s;
+    job->notifyFd = job->deferred ? -1 : jobNotifyFd;
+    memcpy(job->args, args, sizeof(job->args));
+    job->path[0] = '\0';
+    if (path != NULL) {
+        strncpy(job->path, path, MAX_CMD_SIZE);
+        job->path[MAX_CMD_SIZE] = '\0';
+    }
+    if (s != NULL) {
+        s->stop = &job->stop;
+    }
+    pthread_mutex_init(&job->lock, NULL);
+    job->running = true;
+    if (job->deferred) {
+        return;
+    }
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = interrupt_job;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, &previousInterrupt);
+    if (pthread_create(&job->thread, NULL, job_thread, job) != 0) {
+        memory_error("Thread creation failed\n");
+        exit(0);
+    }
+}
+
+/* Returns true while the job runs, joining it once it finished */
+bool job_running() {
+    bool finished;
+    if (!currentJob->running) {
+        return false;
+    }
+    pthread_mutex_lock(&currentJob->lock);
+    finished = currentJob->finished;
+    pthread_mutex_unlock(&currentJob->lock);
+    if (finished) {
+        job_join();
+    }
+    return !finished;
+}
+
+/* Runs the work of a deferred job, then joins the job, whether it finishes or is stopped by Ctrl-C meanwhile */
+void job_wait() {
+    if (!currentJob->running) {
+        return;
+    }
+    if (currentJob->deferred && !currentJob->finished) {
+        currentJob->work(currentJob);
+        currentJob->finished = true;
+    }
+    job_join();
+}
+
+/* Sets the stop flag and joins the job */
+bool job_cancel() {
+    if (!currentJob->running) {
+        return false;
+    }
+    currentJob->stop = true;
+    job_wait();
+    return true;
+}
+
+/* Prints the error to the job stream, unless a result line prints it, and keeps it for the current command, the
+ * worker must not touch the command state of the main loop */
+void job_error(commandJob* job, char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(job->error, MAX_ERROR_SIZE, format, args);
+    va_end(args);
+    job->failed = true;
+    if (!resultLines) {
+        fputs(job->error, job->out);
+    }
+}
+
+/* Returns true once the job was asked to stop */
+bool job_stopped(commandJob* job) {
+    return job->stop;
+}
+
+/* Returns the threads the work may start, counting its own */
+int job_threads(commandJob* job) {
+    return job->deferred ? 1 : get_cpu_count();
+}
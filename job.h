@@ -0,0 +1,156 @@
+/** @file job.h
+ *  @brief job header file.
+ *
+ *  This header contains the prototypes for the command job module.
+ *  contains the structure definition of a long running command executed on a worker thread.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_JOB_H
+#define SUDOKU_JOB_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include "bit_solver.h"
+#include "linked_list.h"
+#include <pthread.h>
+
+
+/* -- Defines -- */
+#define JOB_PROGRESS_INTERVAL_NS 1e9 /* time between progress reports */
+#define JOB_SLICE_NODES 4096 /* search nodes between checks of the clock and the budgets */
+
+
+/* -- Structs -- */
+
+/**
+ * @brief commandJob structure representing a long running command (num_solutions, generate) executed on a worker
+ * thread, while the main loop keeps reading commands so it can be cancelled. a deferred job has no thread of its own,
+ * it runs when the thread which started it waits for it (the server workers, which run off the event loop already).
+ * the main loop rejects every other command of the game while its job runs, so the job may update the board and the
+ * moves list.
+ * commandJob contains thread field and work field, the function run by the thread, and finish field, the function
+ * run by the main loop when it joins the thread, which may update the game state and print with print_error
+ * (or NULL).
+ * commandJob contains running field, true from the start until the main loop joined the thread,
+ * finished field, set by the worker when work returned, and deferred field.
+ * commandJob contains stop field, set by the cancel command or Ctrl-C, a deferred job keeps a stop requested before
+ * it started.
+ * commandJob contains board, lst, s, args and path fields, the input of the work function
+ * (unused ones are NULL, 0 or empty).
+ * commandJob contains out field, the stream the work prints to (commandOutput when the job started),
+ * and failed and error fields, set by job_error.
+ * commandJob contains lock field protecting finished.
+ * commandJob contains notifyFd field, the descriptor the worker writes the job address to when work returned
+ * (-1 for none).
+ *
+ */
+typedef struct commandJob {
+    pthread_t thread;
+    void (*work)(struct commandJob*);
+    void (*finish)(struct commandJob*);
+    bool running;
+    bool finished;
+    bool deferred;
+    volatile bool stop;
+    cell** board;
+    list* lst;
+    bitSolver* s;
+    long args[3];
+    char path[MAX_CMD_SIZE + 1];
+    FILE* out;
+    bool failed;
+    char error[MAX_ERROR_SIZE];
+    pthread_mutex_t lock;
+    int notifyFd;
+} commandJob;
+
+
+/** @brief Selects the job the other functions of this module act on.
+ *  @param job job of the game whose command runs, or NULL for the job of the console.
+ *  @return void.
+ */
+void job_select(commandJob* job);
+
+
+/** @brief Makes the jobs started afterwards write their address to the given descriptor when their work returned,
+ *  so a loop waiting for input can finish them at once.
+ *  @param fd descriptor to write to, a pipe, or -1 to stop notifying.
+ *  @return void.
+ */
+void job_notify(int fd);
+
+
+/** @brief Makes the jobs started afterwards by the calling thread deferred: job_wait runs their work on that thread
+ *  instead of a thread of their own, and Ctrl-C doesn't cancel them.
+ *  @param defer true to defer the jobs of the calling thread.
+ *  @return void.
+ */
+void job_defer(bool defer);
+
+
+/** @brief Starts the selected job running given work function on a worker thread, Ctrl-C cancels it until it ends.
+ *  a deferred job only runs once waited for.
+ *  the work prints to the job out stream only, and reports errors with job_error.
+ *  @param work function to run, gets the job.
+ *  @param finish function run on the main loop thread once the work returned, with commandOutput set to the job out
+ *  stream, or NULL.
+ *  @param board sudoku board the work may update.
+ *  @param lst moves list the work may update.
+ *  @param s search context owned by the job and freed when it ends, or NULL.
+ *  @param args work arguments.
+ *  @param path file path argument, or NULL.
+ *  @return void.
+ */
+void job_start(void (*work)(commandJob*), void (*finish)(commandJob*), cell** board, list* lst, bitSolver* s,
+               long args[3], const char* path);
+
+
+/** @brief Returns true while the selected job runs, joining it if it has finished.
+ *  @return true if the job runs, else false.
+ */
+bool job_running();
+
+
+/** @brief Waits for the selected job to finish, if it runs, running the work of a deferred job.
+ *  joining a job runs its finish function and marks the current command as failed if the job failed.
+ *  @return void.
+ */
+void job_wait();
+
+
+/** @brief Stops the selected job and waits for it, the board and moves list stay as they were before it.
+ *  @return true if the job was running, else false.
+ */
+bool job_cancel();
+
+
+/** @brief Prints an error message of the job to its out stream, formatted like printf, unless a result line will
+ *  print it (resultLines), and marks the job as failed.
+ *  the message becomes the error of the current command when the job is joined.
+ *  @param job running job.
+ *  @param format printf format of the message.
+ *  @return void.
+ */
+void job_error(commandJob* job, char* format, ...);
+
+
+/** @brief Returns true if the job was asked to stop.
+ *  @param job running job.
+ *  @return true if stopped, else false.
+ */
+bool job_stopped(commandJob* job);
+
+
+/** @brief Returns the amount of threads the work of the job may run on: every processor for a job of its own thread,
+ *  one for a deferred job, whose thread is one of a fixed pool already.
+ *  @param job running job.
+ *  @return amount of threads.
+ */
+int job_threads(commandJob* job);
+
+
+#endif /*SUDOKU_JOB_H*/
@@ -1,176 +1,181 @@
-/** @file linked_list.c
- *  @brief linked list source file.
- *
- *  This module encapsulates the sudoku puzzle game moves list represented by a linked list.
- *  Includes functions to match all game commands related to moves list to be entered by the user (undo, redo, reset).
- *  Includes auxiliary functions that are relevant specifically to linked_list structure.
- *
- *  @author Itay Keren (itaykeren)
- *  @author Rotem Bar (rotembar)
- *
- */
-
-/* -- Includes -- */
-
-
-
-/* Allocates memory and creates returns a node to be later on added to game moves list represented by a linked list.
- * node board field is updated with given sudoku board (board after a changing command was executed).
- * prev and next field are updated to null and will be updated in the future when added to a list */
-node* create_node(cell** board) {
-    node* newNode = malloc(sizeof(node));
-    if (newNode == NULL) {
-        memory_error("Memory allocation failed\n");
-        exit(0);
-    }
-    newNode->board = board;
-    newNode->prev = NULL;
-    newNode->next = NULL;
-    return newNode;
-}
-/* Allocates memory and creates and returns a linked list which intend to represent game moves list
- * first node in the list (head of list) is created based on given sudoku board (first board in current game)
- * fields head and current are updated to point on head of list,
- * tail is updated to null to mark a newly created list which only contain head*/
-list* create_list(cell** board) {
-    list* lst = malloc(sizeof(list));
-    if (lst == NULL) {
-        memory_error("Memory allocation failed\n");
-        exit(0);
-    }
-    lst->head = create_node(board);
-    lst->tail = NULL;
-    lst->current = lst->head;
-    return lst;
-}
-
-/* Frees given moves list by freeing memory of all nodes and list itself */
-void free_list(list* lst) {
-    node* currentToDel = lst->head;
-    while (currentToDel->next != NULL) {
-        currentToDel = currentToDel->next;
-        free_board(currentToDel->prev->board);
-        free(currentToDel->prev);
-    }
-    free_board(currentToDel->board);
-    free(currentToDel);
-    free(lst);
-    lst = NULL;
-}
-
-/* Updates the given game moves list by deleting all nodes beyond the current pointer
- * update current and tail field to point to newTail and adding it to end of the moves list */
-void delete_next_nodes(node* newTail, list* lst) {
-    node* currentToDel;
-    if (newTail == NULL){
-        return;
-    }
-    currentToDel = lst->current->next;
-    /* adding newTail to the end of the list */
-    newTail->next = NULL;
-    newTail->prev = lst->current;
-    lst->tail = newTail;
-    lst->current->next = newTail;
-    lst->current = newTail;
-    if (currentToDel == NULL) {
-        return; /* no nodes to delete */
-    } else {
-        while (currentToDel->next != NULL) {
-            currentToDel = currentToDel->next;
-            free_board(currentToDel->prev->board); /* deleting nodes by  memory freeing */
-            free(currentToDel->prev);
-        }
-    }
-    free_board(currentToDel->board);
-    free(currentToDel);
-}
-
-/* Updates given game moves list by generating a new node based on given board and adding it to the end of the list
- * if undo was made and then a new move was made, redo moves are deleted. */
-void insert_at_tail(cell** board, list* lst) {
-    node* temp = lst->current;
-    node* newNode = create_node(board);
-    if (temp == lst->head) { /* first move of the game*/
-        lst->head->next = newNode;
-        newNode->prev = lst->head;
-        lst->current = newNode;
-        lst->tail = newNode;
-        return;
-    } else if (temp != lst->tail){ /* undo was made and then a new move was made */
-        delete_next_nodes(newNode, lst); /* deleting available redos moves */
-    } else { /* standard move */
-        lst->tail->next = newNode;
-        newNode->prev = lst->tail;
-        lst->tail = newNode;
-        lst->current = newNode;
-    }
-}
-
- /* Prints messages corresponding moves made from oldBoard to create newBoard
-  * cmdType representing redo or undo command*/
-void print_board_changes(cell** oldBoard, cell** newBoard, char* cmdType) {
-    int i, j, oldVal, newVal;
-    int N = blockRows * blockCols;
-    for (i = 0; i < N; i++) {
-        for (j = 0; j < N; j++) {
-            oldVal = oldBoard[i][j].number;
-            newVal = newBoard[i][j].number;
-            if (oldVal != newVal) {
-                if (oldVal == UNASSIGNED) {
-                    printf("%s %d,%d: from _ to %d\n",cmdType, j + 1, i + 1, newVal);
-                } else if (newVal == UNASSIGNED) {
-                    printf("%s %d,%d: from %d to _\n",cmdType, j + 1, i + 1, oldVal);
-                } else {
-                    printf("%s %d,%d: from %d to %d\n",cmdType, j + 1, i + 1, oldVal, newVal);
-                }
-            }
-        }
-    }
-}
-
-/* updates given sudoku board and moves list by redoing next move available in moves list.
- * if no move available to redo (current has no next) print appropriate messages.
- * if a move was redo prints new board and changes made. */
-void redo(list* lst, cell** board, char mode){
-    node* newCurrent;
-    if ((lst->current == lst->tail) || (lst->head->next == NULL)) {
-        printf("Error: no moves to redo\n");
-        return;
-    }
-    newCurrent = lst->current->next;
-    copy_board(newCurrent->board, board);
-    print_board(board, mode);
-    print_board_changes(lst->current->board, newCurrent->board, "Redo");
-    lst->current = newCurrent;
-}
-
-/* updates given sudoku board and moves list by undoing the last move available in moves list.
- * if no move available to undo (current has no prev) print appropriate messages.
- * if a move was undo prints new board and changes made. */
-void undo(list* lst, cell** board, char mode){
-    node* newCurrent;
-    if ((lst->current == lst->head) || (lst->head->next == NULL)){
-        printf("Error: no moves to undo\n");
-        return;
-    }
-    newCurrent = lst->current->prev;
-    copy_board(newCurrent->board, board);
-    print_board(board, mode);
-    print_board_changes(lst->current->board, newCurrent->board, "Undo");
-    lst->current = newCurrent;
-}
-
-/* updates given sudoku board and moves list by resetting board to originally loaded or generated board (head of the list).
- * all nodes of moves list except for the head are deleted.
- * prints the original board. */
-void reset(list* lst, cell** board, char mode){
-    if (lst->head->next == NULL){ /* no moves were made */
-        print_board(board, mode);
-        printf("Board reset\n");
-        return;
-    }
-    delete_next_nodes(lst->head, lst);
-    copy_board(lst->current->board, board);
-    print_board(board, mode);
-    printf("Board reset\n");
-}
+/** @file linked_list.c
+ *  @brief linked list source file.
+ *
+ *  This module encapsulates the sudoku puzzle game moves list.
+ *  Includes functions to match all game commands related to moves list to be entered by the user (undo, redo, reset).
+ *  The moves are kept as the cells they changed by the history module, which libsudoku uses as well, so a move
+ *  costs memory for its changed cells only; the list compares the board after a move with its own copy of the board
+ *  to find them.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "linked_list.h"
+#include "cache.h"
+#include "game.h"
+#include "history.h"
+#include "main_aux.h"
+#include "stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/* Returns the memory held by the moves list: the list, its board and its changes */
+long list_bytes(list* lst) {
+    long N = blockRows * blockCols;
+    return (long) sizeof(list) + N * (long) sizeof(cell*) + N * N * (long) sizeof(cell) + history_bytes(&lst->moves);
+}
+
+/* Allocates memory and creates and returns a moves list without moves, holding the given sudoku board
+ * (first board in current game) */
+list* create_list(cell** board) {
+    list* lst = malloc(sizeof(list));
+    if (lst == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    history_init(&lst->moves);
+    lst->board = board;
+    STATS_ADD(historyBytes, list_bytes(lst));
+    return lst;
+}
+
+/* Frees given moves list: its changes, its board and the list itself */
+void free_list(list* lst) {
+    STATS_ADD(historyBytes, -list_bytes(lst));
+    history_free(&lst->moves);
+    free_board(lst->board);
+    free(lst);
+}
+
+/* Updates given game moves list with a move made of the cells whose value differs between the given board and the
+ * board of the list, a move which changed no cell is recorded as a change of the first cell to its own value so it
+ * is still undone on its own. if undo was made and then a new move was made, redo moves are deleted. */
+void insert_at_tail(cell** board, list* lst) {
+#ifndef SUDOKU_NO_STATS
+    long bytes = list_bytes(lst);
+#endif
+    int i, j, step, changed = 0;
+    int N = blockRows * blockCols;
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            if (board[i][j].number != lst->board[i][j].number) {
+                changed++;
+            }
+        }
+    }
+    if (!history_reserve(&lst->moves, (changed > 0) ? changed : 1)) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    step = history_next_step(&lst->moves);
+    if (changed == 0) {
+        history_record(&lst->moves, 0, board[0][0].number, board[0][0].number, step);
+    }
+    for (i = 0; i < N && changed > 0; i++) {
+        for (j = 0; j < N; j++) {
+            if (board[i][j].number != lst->board[i][j].number) {
+                history_record(&lst->moves, i * N + j, lst->board[i][j].number, board[i][j].number, step);
+            }
+        }
+    }
+    copy_board(board, lst->board);
+    STATS_ADD(historyBytes, list_bytes(lst) - bytes);
+}
+
+/* Restores the values of the changes first to last of the moves list on given board, the values before them
+ * (undone, last change first) or after them, updating the board hash, the erroneous cells and the board of the list */
+void apply_changes(list* lst, cell** board, int first, int last, bool undone) {
+    historyChange* change;
+    int i, j, value;
+    int N = blockRows * blockCols;
+    for (i = 0; i < last - first; i++) {
+        change = &lst->moves.changes[undone ? last - 1 - i : first + i];
+        value = undone ? change->before : change->after;
+        update_board_hash(change->idx % N + 1, change->idx / N + 1, board[change->idx / N][change->idx % N].number,
+                          value);
+        board[change->idx / N][change->idx % N].number = value;
+    }
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            board[i][j].asterisk = false;
+        }
+    }
+    mark_asterisks(board);
+    copy_board(board, lst->board);
+}
+
+ /* Prints messages corresponding the changes first to last of the moves list, from their values after to before
+  * them when undone, cmdType representing redo or undo command*/
+void print_board_changes(list* lst, int first, int last, bool undone, char* cmdType) {
+    historyChange* change;
+    int i, oldVal, newVal;
+    int N = blockRows * blockCols;
+    for (i = first; i < last; i++) {
+        change = &lst->moves.changes[i];
+        oldVal = undone ? change->after : change->before;
+        newVal = undone ? change->before : change->after;
+        if (oldVal != newVal) {
+            if (oldVal == UNASSIGNED) {
+                fprintf(commandOutput, "%s %d,%d: from _ to %d\n",cmdType, change->idx % N + 1, change->idx / N + 1,
+                        newVal);
+            } else if (newVal == UNASSIGNED) {
+                fprintf(commandOutput, "%s %d,%d: from %d to _\n",cmdType, change->idx % N + 1, change->idx / N + 1,
+                        oldVal);
+            } else {
+                fprintf(commandOutput, "%s %d,%d: from %d to %d\n",cmdType, change->idx % N + 1, change->idx / N + 1,
+                        oldVal, newVal);
+            }
+        }
+    }
+}
+
+/* updates given sudoku board and moves list by redoing next move available in moves list.
+ * if no move available to redo prints appropriate messages.
+ * if a move was redo prints new board and changes made. */
+void redo(list* lst, cell** board, char mode){
+    int first, last;
+    if (!history_redo(&lst->moves, &first, &last)) {
+        print_error("Error: no moves to redo\n");
+        return;
+    }
+    apply_changes(lst, board, first, last, false);
+    print_board(board, mode);
+    print_board_changes(lst, first, last, false, "Redo");
+}
+
+/* updates given sudoku board and moves list by undoing the last move available in moves list.
+ * if no move available to undo prints appropriate messages.
+ * if a move was undo prints new board and changes made. */
+void undo(list* lst, cell** board, char mode){
+    int first, last;
+    if (!history_undo(&lst->moves, &first, &last)) {
+        print_error("Error: no moves to undo\n");
+        return;
+    }
+    apply_changes(lst, board, first, last, true);
+    print_board(board, mode);
+    print_board_changes(lst, first, last, true, "Undo");
+}
+
+/* updates given sudoku board and moves list by resetting board to originally loaded or generated board,
+ * undoing every applied move, and deletes all the moves.
+ * prints the original board. */
+void reset(list* lst, cell** board, char mode){
+#ifndef SUDOKU_NO_STATS
+    long bytes = list_bytes(lst);
+#endif
+    if (lst->moves.count == 0){ /* no moves were made */
+        print_board(board, mode);
+        fprintf(commandOutput, "Board reset\n");
+        return;
+    }
+    apply_changes(lst, board, 0, lst->moves.position, true);
+    history_free(&lst->moves);
+    STATS_ADD(historyBytes, list_bytes(lst) - bytes);
+    print_board(board, mode);
+    fprintf(commandOutput, "Board reset\n");
+}
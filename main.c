@@ -8,121 +8,199 @@
  *
  */
 
+/* -- Defines -- */
+#define _GNU_SOURCE
+
 
 /* -- Includes -- */
 #include "main_aux.h"
 #include "parser.h"
 #include "game.h"
 #include "linked_list.h"
+#include "batch.h"
+#include "shard.h"
+#include "server.h"
+#include "render.h"
+#include "prng.h"
+#include "cache.h"
+#include "background.h"
+#include "job.h"
+#include "stats.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/select.h>
 
 
-/* -- Global Variables -- */
-int blockRows;
-int blockCols;
-int markErrors = 1;
-char mode = 'I';
-bool gameOver = false;
+/* Reads the next command line like fgets. with a job pipe, the job which notifies it that it ended is finished while
+ * waiting for the line, so its result is printed without waiting for the next command */
+char* read_command(char* command, FILE* input, int jobFd) {
+    fd_set fds;
+    commandJob* job;
+    int inputFd = fileno(input);
+    while (jobFd >= 0) {
+        FD_ZERO(&fds);
+        FD_SET(inputFd, &fds);
+        FD_SET(jobFd, &fds);
+        if (select((inputFd > jobFd ? inputFd : jobFd) + 1, &fds, NULL, NULL, NULL) < 0) {
+            if (errno == EINTR) { /* Ctrl-C stopping the job */
+                continue;
+            }
+            break;
+        }
+        if (FD_ISSET(jobFd, &fds) && read(jobFd, &job, sizeof(job)) == sizeof(job) && !job_running()
+            && !quietMode) {
+            printf("Enter your command:\n");
+        }
+        if (FD_ISSET(inputFd, &fds)) {
+            break;
+        }
+    }
+    return fgets(command, MAX_CMD_SIZE + 2, input);
+}
 
-int main() {
+int main(int argc, char* argv[]) {
     char* parsedCommand[4] = {'\0', '\0', '\0', '\0'};
-    char* command = malloc(MAX_CMD_SIZE + 2);
+    char* command;
     cell** board;
-    cell** tmpBoard;
-    cell** startingBoard;
     list* movesList;
-    int argsCounter, i, tempRows, tempCols, switchRows, switchCols;
+    int argsCounter, i;
+    int lineNumber = 0;
     bool invalidCmd = false;
+    bool interactive;
+    int jobPipe[2] = {-1, -1};
+    batchOptions batchOpts;
+    FILE* input = stdin;
+    char* scriptPath = NULL;
+#ifndef SUDOKU_NO_STATS
+    double commandStart;
+#endif
+    commandOutput = stdout;
+    if (argc > 1 && strcmp(argv[1], "--batch-solve") == 0) { /* non-interactive batch mode */
+        return parse_batch_args(argc, argv, &batchOpts) ? batch_solve(&batchOpts) : 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "--generate-batch") == 0) { /* non-interactive batch generation mode */
+        return parse_generate_args(argc, argv, &batchOpts) ? generate_batch(&batchOpts) : 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "--generate-from") == 0) { /* non-interactive transform generation mode */
+        return parse_generate_from_args(argc, argv, &batchOpts) ? generate_from_batch(&batchOpts) : 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "--count-shard") == 0) { /* non-interactive shard counting mode */
+        return parse_shard_args(argc, argv, &batchOpts) ? count_shard(&batchOpts) : 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "--merge-shards") == 0) { /* non-interactive shard results merge */
+        return merge_shards(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "--serve") == 0) { /* multi-session server mode */
+        return serve(argc, argv);
+    }
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tty") == 0) {
+            enable_tty_render(); /* keeps plain frames when stdout is not a terminal */
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            quietMode = true;
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            i++;
+            scriptPath = argv[i];
+#ifndef SUDOKU_NO_STATS
+        } else if (strcmp(argv[i], "--stats") == 0 && i + 1 < argc) { /* statistics written as JSON at exit */
+            i++;
+            stats_dump_at_exit(argv[i]);
+#endif
+        } else {
+            fprintf(stderr, USAGE);
+            return 1;
+        }
+    }
+    if (scriptPath != NULL && (input = fopen(scriptPath, "r")) == NULL) {
+        fprintf(stderr, "Error: File doesn't exist or cannot be opened\n");
+        return 1;
+    }
+    resultLines = (scriptPath != NULL);
+    interactive = (scriptPath == NULL && isatty(fileno(input))); /* long commands run while the next one is typed */
+    if (interactive && pipe(jobPipe) == 0) { /* a job which ends is finished at once */
+        setvbuf(input, NULL, _IONBF, 0); /* no typed line waits in the stream while the descriptor is watched */
+        job_notify(jobPipe[1]);
+    }
+    command = malloc(MAX_CMD_SIZE + 2);
     if (command == NULL) {
         memory_error("Memory allocation failed\n");
         exit(0);
     }
-    srand(time(NULL)); /* setting random seed */
-    printf("Sudoku\n------\n");
-    printf("Enter your command:\n");
-    while (fgets(command, MAX_CMD_SIZE + 2, stdin) != NULL) {
-        if (!strchr(command, '\n')) { /* command contains more than 256 chars */
-            while (!strchr(command, '\n')  && fgets(command, MAX_CMD_SIZE + 2, stdin)); /* cleaning buffer */
+    prng_seed(&gameRandom, (unsigned long) time(NULL)); /* setting random seed, the seed command replaces it */
+    if (!quietMode) {
+        printf("Sudoku\n------\n");
+    }
+    if (!quietMode && scriptPath == NULL) {
+        printf("Enter your command:\n");
+    }
+    while (read_command(command, input, jobPipe[0]) != NULL) {
+        lineNumber++;
+        commandFailed = false;
+        if (!strchr(command, '\n') && !feof(input)) { /* command contains more than 256 chars */
+            while (!strchr(command, '\n')  && fgets(command, MAX_CMD_SIZE + 2, input)); /* cleaning buffer */
             invalidCmd = true;
-            printf(INVALID_ERROR);
+            print_error(INVALID_ERROR);
 
         }
         argsCounter = parseCommand(command, parsedCommand);
-        tmpBoard = NULL;
+#ifndef SUDOKU_NO_STATS
+        commandStart = get_time_ns();
+#endif
+        if (scriptPath != NULL && parsedCommand[0] != NULL && parsedCommand[0][0] == '#') { /* script comment */
+            parsedCommand[0] = NULL;
+        }
         if (parsedCommand[0] == NULL) {/* Handles blank line */
-        } else if (strcmp(parsedCommand[0], "solve") == 0 && !invalidCmd) {
-            tempRows = blockRows;
-            tempCols = blockCols;
-            tmpBoard = solve_command(parsedCommand, 'S');
-            if (tmpBoard != NULL) { /* solve succeeded */
-                if (mode != 'I' || gameOver) { /* switching mode from edit or old solve to new solve */
-                    switchRows = blockRows;
-                    switchCols = blockCols;
-                    blockRows = tempRows;
-                    blockCols = tempCols;
-                    free_board(board);
-                    free_list(movesList);
-                    blockRows = switchRows;
-                    blockCols = switchCols;
-                }
-                mode = 'S';
-                board = NULL;
-                board = generate_empty_board();
-                copy_board(tmpBoard, board);
-                free_board(tmpBoard);
-                startingBoard = NULL;
-                startingBoard = generate_empty_board();
-                copy_board(board, startingBoard);
-                movesList = NULL;
-                movesList = create_list(startingBoard);
-            }
-        } else if (strcmp(parsedCommand[0], "edit") == 0 && !invalidCmd) {
-            tempRows = blockRows;
-            tempCols = blockCols;
-            tmpBoard = edit_command(parsedCommand, 'E');
-            if (tmpBoard != NULL) { /* edit succeeded */
-                if (mode != 'I' || gameOver) { /* switching mode from solve or old edit to new edit */
-                    switchRows = blockRows;
-                    switchCols = blockCols;
-                    blockRows = tempRows;
-                    blockCols = tempCols;
+        } else if (job_running() && strcmp(parsedCommand[0], "cancel") != 0 && strcmp(parsedCommand[0], "exit") != 0) {
+            print_error("Error: a command is running, use cancel to stop it\n");
+        } else if (!invalidCmd) {
+            dispatch_command(parsedCommand, &board, &movesList, command, argsCounter);
+        }
+        if (!interactive) { /* scripts and piped input run one command at a time */
+            job_wait();
+        }
+#ifndef SUDOKU_NO_STATS
+        if (parsedCommand[0] != NULL) { /* a job started interactively is timed until it started */
+            stats_record_command(parsedCommand[0], get_time_ns() - commandStart);
+        }
+#endif
+        if (scriptPath != NULL && (parsedCommand[0] != NULL || commandFailed)) {
+            print_command_result(lineNumber, parsedCommand[0]);
+            if (commandFailed) { /* script stops at the first failing command */
+                if (mode != 'I') {
                     free_board(board);
                     free_list(movesList);
-                    blockRows = switchRows;
-                    blockCols = switchCols;
                 }
-                mode = 'E';
-                board = NULL;
-                board = generate_empty_board();
-                copy_board(tmpBoard, board);
-                free_board(tmpBoard);
-                startingBoard = NULL;
-                startingBoard = generate_empty_board();
-                copy_board(board, startingBoard);
-                movesList = NULL;
-                movesList = create_list(startingBoard);
+                free(command);
+                fclose(input);
+                return 1;
             }
         }
-        else if (!invalidCmd){
-            execute_command(parsedCommand, board, command, argsCounter, mode, movesList);
+        if (mode == 'S' && !gameOver) { /* solving the new position in the background, if enabled */
+            background_post(board, boardHash);
+        } else {
+            background_cancel();
         }
         for (i = 0; i < 4; i++){
             parsedCommand[i] = '\0';
         }
         invalidCmd = false;
-        printf("Enter your command:\n");
+        if (!quietMode && scriptPath == NULL) {
+            printf("Enter your command:\n");
+        }
     }
-    if (feof(stdin)) { /* EOF */
+    job_cancel();
+    if (feof(input)) { /* EOF */
         if (mode != 'I') { /* freeing memory if not in 'I' mode */
             free_board(board);
             free_list(movesList);
         }
         exit_game(command);
     }
-    else if (ferror(stdin)) { /* Error */
+    else if (ferror(input)) { /* Error */
         if (mode != 'I') { /* freeing memory if not in 'I' mode */
             free_board(board);
             free_list(movesList);
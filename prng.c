@@ -0,0 +1,68 @@
+/** @file prng.c
+ *  @brief prng source file.
+ *
+ *  This module implements the xoshiro128** pseudo random generator.
+ *  Words are kept in unsigned longs masked to 32 bits, so the generator needs no 64 bit type.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "prng.h"
+
+/* -- Defines -- */
+#define WORD_MASK 0xFFFFFFFFUL
+
+
+/* Rotates a 32 bit word left by k bits */
+unsigned long rotate_left(unsigned long x, int k) {
+    return ((x << k) | (x >> (32 - k))) & WORD_MASK;
+}
+
+/* Returns the next output of the splitmix32 sequence, used to spread a seed over the whole state */
+unsigned long splitmix_next(unsigned long* x) {
+    unsigned long z;
+    *x = (*x + 0x9E3779B9UL) & WORD_MASK;
+    z = *x;
+    z = ((z ^ (z >> 16)) * 0x85EBCA6BUL) & WORD_MASK;
+    z = ((z ^ (z >> 13)) * 0xC2B2AE35UL) & WORD_MASK;
+    return z ^ (z >> 16);
+}
+
+/* Seeds the generator, folding the high bits of a wide seed into the low word first */
+void prng_seed(prng* r, unsigned long seed) {
+    unsigned long x = (seed & WORD_MASK) ^ ((seed >> 16 >> 16) * 0x9E3779B9UL & WORD_MASK);
+    int i;
+    for (i = 0; i < 4; i++) {
+        r->state[i] = splitmix_next(&x);
+    }
+    if ((r->state[0] | r->state[1] | r->state[2] | r->state[3]) == 0) { /* the all zero state is a fixed point */
+        r->state[0] = 1;
+    }
+}
+
+/* Returns the next 32 random bits */
+unsigned long prng_next(prng* r) {
+    unsigned long* s = r->state;
+    unsigned long result = (rotate_left((s[1] * 5) & WORD_MASK, 7) * 9) & WORD_MASK;
+    unsigned long t = (s[1] << 9) & WORD_MASK;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotate_left(s[3], 11);
+    return result;
+}
+
+/* Returns a random integer below bound, rejecting the lowest outputs which would make the modulo biased */
+int prng_below(prng* r, int bound) {
+    unsigned long threshold = (WORD_MASK - (unsigned long) bound + 1) % (unsigned long) bound; /* 2^32 mod bound */
+    unsigned long x;
+    do {
+        x = prng_next(r);
+    } while (x < threshold);
+    return (int) (x % (unsigned long) bound);
+}
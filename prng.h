@@ -0,0 +1,59 @@
+/** @file prng.h
+ *  @brief prng header file.
+ *
+ *  This header contains the prototypes for the prng module.
+ *  contains the structure definition of a pseudo random generator state.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_PRNG_H
+#define SUDOKU_PRNG_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+
+
+/* -- Structs -- */
+
+/**
+ * @brief prng structure representing the state of a xoshiro128** pseudo random generator.
+ * prng contains state field, four 32 bit words kept in unsigned longs.
+ * every thread (or generator) owns its own state, so sequences are reproducible and need no locking.
+ *
+ */
+typedef struct prng {
+    unsigned long state[4];
+} prng;
+
+
+/* -- Global Variables  -- */
+extern __thread prng gameRandom; /* generator of the interactive game, seeded by time or the seed command */
+
+
+/** @brief Seeds given generator, equal seeds produce equal sequences.
+ *  @param r generator to seed.
+ *  @param seed any value.
+ *  @return void.
+ */
+void prng_seed(prng* r, unsigned long seed);
+
+
+/** @brief Returns the next 32 random bits of given generator.
+ *  @param r generator.
+ *  @return value between 0 and 2^32 - 1.
+ */
+unsigned long prng_next(prng* r);
+
+
+/** @brief Returns a uniformly distributed random integer below given bound, without modulo bias.
+ *  @param r generator.
+ *  @param bound positive upper bound (exclusive).
+ *  @return value between 0 and bound - 1.
+ */
+int prng_below(prng* r, int bound);
+
+
+#endif /*SUDOKU_PRNG_H*/
@@ -0,0 +1,95 @@
+/** @file queue.c
+ *  @brief queue source file.
+ *
+ *  This module implements a bounded blocking queue data structure.
+ *  Bounding the queue gives backpressure: a producer faster than its consumers blocks instead of growing memory.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "queue.h"
+#include "main_aux.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Initializes an empty queue */
+void queue_initialize(queue* q, int capacity) {
+    q->items = calloc(capacity, sizeof(void*));
+    if (q->items == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    q->capacity = capacity;
+    q->head = 0;
+    q->count = 0;
+    q->closed = false;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->notEmpty, NULL);
+    pthread_cond_init(&q->notFull, NULL);
+}
+
+/* Pushes an item to the end of the queue, waiting for a free place if needed */
+void queue_push(queue* q, void* item) {
+    pthread_mutex_lock(&q->lock);
+    while (q->count == q->capacity && !q->closed) {
+        pthread_cond_wait(&q->notFull, &q->lock);
+    }
+    if (!q->closed) {
+        q->items[(q->head + q->count) % q->capacity] = item;
+        q->count++;
+        pthread_cond_signal(&q->notEmpty);
+    }
+    pthread_mutex_unlock(&q->lock);
+}
+
+/* Pushes an item to the end of the queue unless it is full or closed */
+bool queue_try_push(queue* q, void* item) {
+    bool pushed = false;
+    pthread_mutex_lock(&q->lock);
+    if (q->count < q->capacity && !q->closed) {
+        q->items[(q->head + q->count) % q->capacity] = item;
+        q->count++;
+        pthread_cond_signal(&q->notEmpty);
+        pushed = true;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return pushed;
+}
+
+/* Pops the oldest item of the queue, waiting for an item if needed. returns NULL once closed and drained */
+void* queue_pop(queue* q) {
+    void* item = NULL;
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0 && !q->closed) {
+        pthread_cond_wait(&q->notEmpty, &q->lock);
+    }
+    if (q->count > 0) {
+        item = q->items[q->head];
+        q->head = (q->head + 1) % q->capacity;
+        q->count--;
+        pthread_cond_signal(&q->notFull);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return item;
+}
+
+/* Closes the queue and wakes up all waiting threads */
+void queue_close(queue* q) {
+    pthread_mutex_lock(&q->lock);
+    q->closed = true;
+    pthread_cond_broadcast(&q->notEmpty);
+    pthread_cond_broadcast(&q->notFull);
+    pthread_mutex_unlock(&q->lock);
+}
+
+/* Frees the queue resources */
+void queue_destroy(queue* q) {
+    pthread_mutex_destroy(&q->lock);
+    pthread_cond_destroy(&q->notEmpty);
+    pthread_cond_destroy(&q->notFull);
+    free(q->items);
+    q->items = NULL;
+}
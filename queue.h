@@ -0,0 +1,89 @@
+/** @file queue.h
+ *  @brief queue header file.
+ *
+ *  This header contains the prototypes for the queue module.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_QUEUE_H
+#define SUDOKU_QUEUE_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include <pthread.h>
+
+/* -- Structs -- */
+
+/**
+ * @brief queue structure representing a bounded blocking FIFO queue shared between threads.
+ * queue contains items field, a circular buffer of capacity pointers.
+ * queue contains head field which indicates the position of the oldest item and count field the amount of items.
+ * queue contains closed field which is true after queue_close() was called, no items can be pushed after that.
+ * queue contains lock, notEmpty and notFull fields used to block poppers on an empty queue and pushers on a full queue.
+ */
+typedef struct queue {
+    void** items;
+    int capacity;
+    int head;
+    int count;
+    bool closed;
+    pthread_mutex_t lock;
+    pthread_cond_t notEmpty;
+    pthread_cond_t notFull;
+} queue;
+
+
+/**
+ *  @brief Initializes an empty queue.
+ *  @param q - Queue to init.
+ *  @param capacity - Maximal amount of items in the queue.
+ *  @return void.
+ */
+void queue_initialize(queue* q, int capacity);
+
+
+/**
+ *  @brief Pushes an item to the end of the queue, blocks while the queue is full.
+ *  @param q - Queue to push item to.
+ *  @param item - Item to push.
+ *  @return void.
+ */
+void queue_push(queue* q, void* item);
+
+
+/**
+ *  @brief Pushes an item to the end of the queue without waiting.
+ *  @param q - Queue to push item to.
+ *  @param item - Item to push.
+ *  @return true if the item was pushed, false if the queue is full or closed.
+ */
+bool queue_try_push(queue* q, void* item);
+
+
+/**
+ *  @brief Pops the oldest item of the queue, blocks while the queue is empty and not closed.
+ *  @param q - Queue to pop item from.
+ *  @return The popped item, NULL if the queue is closed and empty.
+ */
+void* queue_pop(queue* q);
+
+
+/**
+ *  @brief Closes the queue, waking up all threads blocked on it.
+ *  @param q - Queue to close.
+ *  @return void.
+ */
+void queue_close(queue* q);
+
+
+/**
+ *  @brief Frees the resources of the queue (not the items).
+ *  @param q - Queue to destroy.
+ *  @return void.
+ */
+void queue_destroy(queue* q);
+
+#endif /*SUDOKU_QUEUE_H*/
@@ -0,0 +1,286 @@
+/** @file render.c
+ *  @brief render source file.
+ *
+ *  This module renders the sudoku board for the user.
+ *  The whole frame is built in a reusable buffer using precomputed number strings,
+ *  so printing a board costs a single write instead of several stdio calls per cell. Every thread has a buffer of its
+ *  own, as the server workers render the boards of their sessions at once.
+ *  In tty render mode the board is kept at the top of the terminal above a scrolling region for the other output,
+ *  and after the first frame only the cells whose text changed are repainted using ANSI cursor moves.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Defines -- */
+#define _GNU_SOURCE
+
+/* -- Includes -- */
+#include "render.h"
+#include "main_aux.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#define PRECOMPUTED_NUMBERS 100 /* numbers printed as exactly 2 chars ("%2d") */
+#define MAX_CELL_TEXT 14 /* block separator, space, an int and a marker */
+#define CELL_TEXT 3 /* chars of a cell holding a precomputed number */
+#define MAX_ESCAPE 32 /* chars of a cursor escape sequence holding two ints */
+
+
+/* -- Global Variables  -- */
+extern __thread int blockRows;
+extern __thread int blockCols;
+extern __thread int markErrors;
+
+__thread char* frameBuffer = NULL;
+__thread long frameCapacity = 0;
+char numberStrings[PRECOMPUTED_NUMBERS][2];
+pthread_once_t numberStringsOnce = PTHREAD_ONCE_INIT;
+
+bool ttyRender = false;
+char* lastCells = NULL; /* CELL_TEXT chars per cell of the frame currently on the terminal */
+int lastN = 0;
+int lastBlockRows = 0;
+int lastTerminalRows = 0;
+bool lastFrameValid = false;
+
+
+/* fills the table of "%2d" representations of the numbers below PRECOMPUTED_NUMBERS */
+void prepare_number_strings() {
+    int i;
+    for (i = 0; i < PRECOMPUTED_NUMBERS; i++) {
+        numberStrings[i][0] = (char) ((i < 10) ? ' ' : '0' + i / 10);
+        numberStrings[i][1] = (char) ('0' + i % 10);
+    }
+}
+
+/* returns the frame buffer after making sure it can hold the given amount of bytes */
+char* get_frame_buffer(long length) {
+    char* newBuffer;
+    if (length > frameCapacity) {
+        newBuffer = realloc(frameBuffer, length);
+        if (newBuffer == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+        frameBuffer = newBuffer;
+        frameCapacity = length;
+    }
+    return frameBuffer;
+}
+
+/* appends the block separator line to out, returns the amount of chars appended */
+long append_separator(char* out, int N) {
+    long count = 4 * N + blockRows + 1;
+    memset(out, '-', count);
+    out[count] = '\n';
+    return count + 1;
+}
+
+/* appends the 3 chars of a cell (number and marker) to out, returns the amount of chars appended */
+long append_cell(char* out, cell* c, char mode) {
+    char marker = ' ';
+    long count;
+    if (c->isFixed) {
+        marker = '.';
+    } else if (c->asterisk && (markErrors || mode == 'E')) { /* always marking errors in 'E' mode */
+        marker = '*';
+    } else if (c->number == UNASSIGNED) { /* printing blank spaces for UNASSIGNED */
+        out[0] = ' ';
+        out[1] = ' ';
+        out[2] = ' ';
+        return 3;
+    }
+    if (c->number >= 0 && c->number < PRECOMPUTED_NUMBERS) {
+        out[0] = numberStrings[c->number][0];
+        out[1] = numberStrings[c->number][1];
+        count = 2;
+    } else {
+        count = sprintf(out, "%2d", c->number);
+    }
+    out[count] = marker;
+    return count + 1;
+}
+
+/* renders the board into the frame buffer according to the format, game mode and markErrors value.
+ * returns the frame length */
+long build_frame(cell** board, char mode) {
+    int i, j;
+    int N = blockRows * blockCols;
+    long length = 0;
+    char* out = get_frame_buffer((long) (N + blockRows + 1) * (MAX_CELL_TEXT * N + blockRows + 2));
+    pthread_once(&numberStringsOnce, prepare_number_strings);
+    for (i = 0; i < N; i++) {
+        if (i % blockRows == 0) {
+            length += append_separator(out + length, N);
+        }
+        for (j = 0; j < N; j++) {
+            if (j % blockCols == 0) {
+                out[length++] = '|';
+            }
+            out[length++] = ' ';
+            length += append_cell(out + length, &board[i][j], mode);
+        }
+        out[length++] = '|';
+        out[length++] = '\n';
+    }
+    length += append_separator(out + length, N);
+    return length;
+}
+
+/* writes the whole buffer to the file descriptor, retrying on partial or interrupted writes */
+bool write_all(int fd, const char* buffer, long length) {
+    long written;
+    while (length > 0) {
+        written = write(fd, buffer, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        buffer += written;
+        length -= written;
+    }
+    return true;
+}
+
+/* returns the amount of terminal rows, 0 if unknown */
+int get_terminal_rows() {
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0) {
+        return 0;
+    }
+    return size.ws_row;
+}
+
+/* restores the terminal scrolling region and moves the cursor to the last line, registered with atexit() */
+void reset_tty_render() {
+    char reset[MAX_ESCAPE];
+    long length;
+    if (!lastFrameValid) {
+        return;
+    }
+    fflush(stdout);
+    length = sprintf(reset, "\033[r\033[%d;1H", lastTerminalRows);
+    write_all(STDOUT_FILENO, reset, length);
+    lastFrameValid = false;
+}
+
+/* turns tty render mode on if stdout is a terminal, returns true if it was turned on */
+bool enable_tty_render() {
+    if (!isatty(STDOUT_FILENO) || get_terminal_rows() == 0) {
+        return false;
+    }
+    if (!ttyRender) {
+        atexit(reset_tty_render);
+    }
+    ttyRender = true;
+    return true;
+}
+
+/* saves the text of every cell of the board as the frame currently on the terminal */
+void save_cells(cell** board, char mode) {
+    int i, j;
+    int N = blockRows * blockCols;
+    if (N != lastN || lastCells == NULL) {
+        free(lastCells);
+        lastCells = malloc((long) N * N * CELL_TEXT);
+        if (lastCells == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+    }
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            append_cell(lastCells + ((long) i * N + j) * CELL_TEXT, &board[i][j], mode);
+        }
+    }
+    lastN = N;
+    lastBlockRows = blockRows;
+}
+
+/* clears the terminal, draws the whole frame at the top and limits scrolling to the lines below it */
+void render_tty_full(cell** board, char mode, int terminalRows) {
+    char escape[2 * MAX_ESCAPE];
+    long length;
+    int frameLines = blockRows * blockCols + blockRows + 1;
+    length = build_frame(board, mode);
+    write_all(STDOUT_FILENO, "\033[r\033[H\033[2J", 10);
+    write_all(STDOUT_FILENO, frameBuffer, length);
+    length = sprintf(escape, "\033[%d;%dr\033[%d;1H", frameLines + 1, terminalRows, frameLines + 1);
+    write_all(STDOUT_FILENO, escape, length);
+    save_cells(board, mode);
+    lastTerminalRows = terminalRows;
+    lastFrameValid = true;
+}
+
+/* repaints only the chars of the cells which differ from the frame on the terminal, keeping the cursor position */
+void render_tty_changes(cell** board, char mode) {
+    int i, j, first, last;
+    int N = blockRows * blockCols;
+    long length = 0;
+    char text[MAX_CELL_TEXT];
+    char* saved;
+    char* out = get_frame_buffer((long) N * N * (MAX_ESCAPE + CELL_TEXT) + 4);
+    out[length++] = '\033';
+    out[length++] = '7'; /* saving cursor position */
+    for (i = 0; i < N; i++) {
+        for (j = 0; j < N; j++) {
+            append_cell(text, &board[i][j], mode);
+            saved = lastCells + ((long) i * N + j) * CELL_TEXT;
+            for (first = 0; first < CELL_TEXT && text[first] == saved[first]; first++);
+            if (first == CELL_TEXT) {
+                continue;
+            }
+            for (last = CELL_TEXT - 1; text[last] == saved[last]; last--);
+            /* the frame line of row i follows i rows and i / blockRows + 1 separators,
+             * cell j follows j cells of 4 chars, j / blockCols + 1 block separators and a space */
+            length += sprintf(out + length, "\033[%d;%dH", i + i / blockRows + 2, 4 * j + j / blockCols + 3 + first);
+            memcpy(out + length, text + first, last - first + 1);
+            length += last - first + 1;
+            memcpy(saved, text, CELL_TEXT);
+        }
+    }
+    out[length++] = '\033';
+    out[length++] = '8'; /* restoring cursor position */
+    if (length > 4) {
+        write_all(STDOUT_FILENO, out, length);
+    }
+}
+
+/* renders the board and writes the frame to out. the console frame is written to stdout in a single write,
+ * after flushing earlier buffered output to keep the order; in tty render mode only the changes since the last
+ * frame are drawn when possible. any other stream (a captured server response) gets the plain frame */
+void render_board(FILE* out, cell** board, char mode) {
+    long length;
+    int terminalRows;
+    int N = blockRows * blockCols;
+    if (out != stdout) {
+        length = build_frame(board, mode);
+        fwrite(frameBuffer, 1, length, out);
+        return;
+    }
+    fflush(stdout);
+    if (ttyRender && N < PRECOMPUTED_NUMBERS) {
+        terminalRows = get_terminal_rows();
+        if (terminalRows > N + blockRows + 2) { /* board and at least one line of output fit */
+            pthread_once(&numberStringsOnce, prepare_number_strings);
+            if (lastFrameValid && N == lastN && blockRows == lastBlockRows && terminalRows == lastTerminalRows) {
+                render_tty_changes(board, mode);
+            } else {
+                render_tty_full(board, mode, terminalRows);
+            }
+            return;
+        }
+        reset_tty_render(); /* terminal too small, falling back to plain frames */
+    }
+    length = build_frame(board, mode);
+    write_all(STDOUT_FILENO, frameBuffer, length);
+}
@@ -0,0 +1,45 @@
+/** @file render.h
+ *  @brief render header file.
+ *
+ *  This header contains the prototypes for the render module.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_RENDER_H
+#define SUDOKU_RENDER_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+
+
+/** @brief Turns tty render mode on if stdout is a terminal.
+ *  in tty render mode the board stays at the top of the terminal and only changed cells are repainted.
+ *  @return true if tty render mode was turned on, false if stdout is not a terminal.
+ */
+bool enable_tty_render();
+
+
+/** @brief Renders given sudoku board into the frame buffer and writes the whole frame to given stream at once,
+ *  to stdout in a single write. the output is identical to printing the board cell by cell, unless tty render mode
+ *  is on and out is stdout.
+ *  @param out stream to write the frame to.
+ *  @param board sudoku board of the global board dimensions.
+ *  @param mode game mode to print board according to relevant restrictions.
+ *  @return void.
+ */
+void render_board(FILE* out, cell** board, char mode);
+
+
+/** @brief Writes given buffer to given file descriptor, retrying on partial or interrupted writes.
+ *  @param fd file descriptor.
+ *  @param buffer bytes to write.
+ *  @param length amount of bytes.
+ *  @return true if all bytes were written, else false.
+ */
+bool write_all(int fd, const char* buffer, long length);
+
+
+#endif /*SUDOKU_RENDER_H*/
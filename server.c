@@ -0,0 +1,629 @@
+/** @file server.c
+ *  @brief server source file.
+ *
+ *  This module serves many games from one process over a Unix domain socket, in place of one console process per
+ *  player. An epoll loop accepts the connections and reads their commands; every connection is a session owning the
+ *  game state which the game module keeps in global variables (board, moves list, dimensions, mode, random state).
+ *  The commands run on a fixed pool of worker threads fed by a bounded queue, so neither a slow command (a count,
+ *  an ILP solve) stalls the other sessions nor do many sessions start unbounded threads: a worker runs a command with
+ *  the state of its session swapped into the game globals of its thread and commandOutput pointing at a memory stream,
+ *  so it is executed by the same code as the console, runs the job the command started itself, and writes the session
+ *  to a pipe watched by the loop, which then queues the output on the session and sends it without blocking.
+ *  A session rejects its other commands while one runs, cancel stops its job. The workers share the solutions cache
+ *  of the process.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Defines -- */
+#define _GNU_SOURCE
+
+/* -- Includes -- */
+#include "server.h"
+#include "main_aux.h"
+#include "parser.h"
+#include "game.h"
+#include "cache.h"
+#include "job.h"
+#include "prng.h"
+#include "queue.h"
+#include "count_table.h"
+#include "stats.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+
+/* -- Global Variables  -- */
+volatile sig_atomic_t serverStop = 0;
+queue commandQueue; /* sessions whose command waits for a worker */
+int commandDoneFd = -1; /* pipe the workers write the session of a command to when it ended */
+
+
+/* SIGINT and SIGTERM handler: ends the event loop */
+void stop_server(int signum) {
+    (void) signum;
+    serverStop = 1;
+}
+
+/* Loads the game state of the session into the game globals */
+void session_enter(clientSession* c) {
+    blockRows = c->blockRows;
+    blockCols = c->blockCols;
+    markErrors = c->markErrors;
+    mode = c->mode;
+    gameOver = c->gameOver;
+    boardHash = c->boardHash;
+    gameRandom = c->random;
+    countTableMegabytes = c->countTableMegabytes;
+    job_select(&c->job);
+}
+
+/* Saves the game globals, as left by a command, into the session */
+void session_leave(clientSession* c) {
+    c->blockRows = blockRows;
+    c->blockCols = blockCols;
+    c->markErrors = markErrors;
+    c->mode = mode;
+    c->gameOver = gameOver;
+    c->boardHash = boardHash;
+    c->random = gameRandom;
+    c->countTableMegabytes = countTableMegabytes;
+    job_select(NULL);
+}
+
+/* Appends a response to the output queue of the session, dropping what was already sent first */
+void session_queue(clientSession* c, const char* response, size_t length) {
+    if (c->outputSent > 0) {
+        memmove(c->output, c->output + c->outputSent, c->outputLength - c->outputSent);
+        c->outputLength -= c->outputSent;
+        c->outputSent = 0;
+    }
+    if (c->outputLength + length > c->outputCapacity) {
+        while (c->outputLength + length > c->outputCapacity) {
+            c->outputCapacity = (c->outputCapacity == 0) ? SERVER_READ_SIZE : c->outputCapacity * 2;
+        }
+        c->output = realloc(c->output, c->outputCapacity);
+        if (c->output == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+    }
+    memcpy(c->output + c->outputLength, response, length);
+    c->outputLength += length;
+}
+
+/* Opens a memory stream capturing the output of a command into the given buffer */
+FILE* session_stream(char** buffer, size_t* length) {
+    FILE* out = open_memstream(buffer, length);
+    if (out == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    return out;
+}
+
+/* Prints the result line of a command of the session answered by the loop to its stream if it had a command or
+ * failed, closes the stream and queues the output captured in the given buffer */
+void session_result(clientSession* c, FILE* out, char** buffer, size_t* length, int lineNumber, char* command,
+                    double start) {
+    FILE* console = commandOutput;
+    commandOutput = out;
+    if (command != NULL || commandFailed) {
+        print_command_result(lineNumber, command);
+    }
+    fclose(out);
+    commandOutput = console;
+    session_queue(c, *buffer, *length);
+    free(*buffer);
+    *buffer = NULL;
+#ifndef SUDOKU_NO_STATS
+    if (command != NULL) {
+        stats_record_command(command, get_time_ns() - start);
+    }
+#else
+    (void) start;
+#endif
+}
+
+/* Runs the parsed command of the session on a worker thread, with its job, capturing its output and result line */
+void session_execute(clientSession* c) {
+    session_enter(c);
+    commandOutput = c->pendingOutput;
+    commandFailed = false;
+    dispatch_command(c->parsedCommand, &c->board, &c->movesList, c->commandLine, c->argsCounter);
+    job_wait();
+    print_command_result(c->pendingLine, c->parsedCommand[0]);
+    fclose(c->pendingOutput);
+    commandOutput = NULL;
+    session_leave(c);
+}
+
+/* Worker thread: runs the commands of the queued sessions until the queue is closed */
+void* session_worker(void* arg) {
+    clientSession* c;
+    (void) arg;
+    job_defer(true); /* the jobs run on the worker which runs their command */
+    while ((c = (clientSession*) queue_pop(&commandQueue)) != NULL) {
+        session_execute(c);
+        while (write(commandDoneFd, &c, sizeof(c)) < 0 && errno == EINTR); /* a pipe write this small is atomic */
+    }
+    return NULL;
+}
+
+/* Queues the parsed command of the session for the workers, returns false if the queue is full */
+bool session_submit(clientSession* c, int lineNumber, double start) {
+    c->pendingOutput = session_stream(&c->pending, &c->pendingLength);
+    c->pendingLine = lineNumber;
+    c->pendingStart = start;
+    c->job.stop = c->stopping;
+    c->running = true;
+    if (queue_try_push(&commandQueue, c)) {
+        return true;
+    }
+    c->running = false;
+    fclose(c->pendingOutput);
+    free(c->pending);
+    c->pending = NULL;
+    return false;
+}
+
+/* Answers a line of the session at once with the given error, or with its result line only for a NULL error */
+void session_answer(clientSession* c, int lineNumber, char* command, char* error, double start) {
+    char* response = NULL;
+    size_t length = 0;
+    FILE* console = commandOutput;
+    FILE* out = session_stream(&response, &length);
+    commandOutput = out;
+    commandFailed = false;
+    if (error != NULL) {
+        print_error(error);
+    }
+    commandOutput = console;
+    session_result(c, out, &response, &length, lineNumber, command, start);
+}
+
+/* Runs one line of the session while no command of it runs, like the script loop does: a command is queued for the
+ * workers and answered when it ended, the loop answers the rest at once */
+void session_command(clientSession* c, char* line, bool tooLong, int lineNumber) {
+    double start = get_time_ns();
+    int i;
+    if (tooLong) {
+        session_answer(c, lineNumber, NULL, INVALID_ERROR, start);
+        return;
+    }
+    strcpy(c->commandLine, line); /* parsed into the session, where the worker finds it */
+    for (i = 0; i < 4; i++) { /* a blank line sets none */
+        c->parsedCommand[i] = NULL;
+    }
+    c->argsCounter = parseCommand(c->commandLine, c->parsedCommand);
+    if (c->parsedCommand[0] == NULL) { /* blank line */
+    } else if (strcmp(c->parsedCommand[0], "exit") == 0) { /* ends the session, not the server */
+        c->closing = true;
+        session_answer(c, lineNumber, c->parsedCommand[0], NULL, start);
+    } else if (!session_submit(c, lineNumber, start)) {
+        session_answer(c, lineNumber, c->parsedCommand[0], "Error: the server is busy, try again later\n", start);
+    }
+}
+
+/* Holds a line the session sent while its command runs, to run it when the command ended */
+void session_hold(clientSession* c, char* line, bool tooLong) {
+    size_t size = sizeof(int) + 1 + strlen(line) + 1;
+    if (c->heldLength + size > c->heldCapacity) {
+        c->heldCapacity = 2 * c->heldCapacity + size;
+        c->held = (char*) realloc(c->held, c->heldCapacity);
+        if (c->held == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+    }
+    memcpy(c->held + c->heldLength, &c->lineNumber, sizeof(int));
+    c->held[c->heldLength + sizeof(int)] = (char) tooLong;
+    strcpy(c->held + c->heldLength + sizeof(int) + 1, line);
+    c->heldLength += size;
+    c->heldLines++;
+}
+
+/* Runs the held lines of the session in order until one of them queues a command or none is left */
+void session_resume(clientSession* c) {
+    int lineNumber;
+    bool tooLong;
+    char* line;
+    while (!c->running && c->heldLines > 0) {
+        memcpy(&lineNumber, c->held + c->heldRead, sizeof(int));
+        tooLong = c->held[c->heldRead + sizeof(int)];
+        line = c->held + c->heldRead + sizeof(int) + 1;
+        c->heldRead += sizeof(int) + 1 + strlen(line) + 1;
+        c->heldLines--;
+        session_command(c, line, tooLong, lineNumber);
+    }
+    if (c->heldLines == 0) {
+        c->heldLength = 0;
+        c->heldRead = 0;
+    }
+}
+
+/* Handles one line of the session: run at once if no command of the session runs, else held for it. cancel stops the
+ * running command and is answered after it, exit stops it and the held commands and is answered after them */
+void session_line(clientSession* c, char* line, bool tooLong) {
+    char copy[MAX_CMD_SIZE + 2];
+    char* parsedCommand[4] = {NULL, NULL, NULL, NULL};
+    double start = get_time_ns();
+    bool exitLine;
+    c->lineNumber++;
+    if (!c->running) {
+        session_command(c, line, tooLong, c->lineNumber);
+        return;
+    }
+    if (!tooLong) {
+        strcpy(copy, line);
+        parseCommand(copy, parsedCommand);
+    }
+    exitLine = parsedCommand[0] != NULL && strcmp(parsedCommand[0], "exit") == 0;
+    if (exitLine) { /* the lines after it are not read */
+        c->job.stop = true;
+        c->stopping = true;
+        c->closing = true;
+    }
+    if (!exitLine && parsedCommand[0] != NULL && strcmp(parsedCommand[0], "cancel") == 0 && c->stopLine == 0) {
+        c->job.stop = true;
+        c->stopLine = c->lineNumber;
+        c->stopStart = start;
+    } else if (!exitLine && c->heldLines >= SERVER_HELD_LINES) {
+        session_answer(c, c->lineNumber, parsedCommand[0], "Error: too many commands are waiting, wait for their "
+                       "results\n", start);
+    } else {
+        session_hold(c, line, tooLong);
+    }
+}
+
+/* Splits the received bytes into lines and handles them, a line longer than MAX_CMD_SIZE fails as in the console */
+void session_receive(clientSession* c, const char* data, long length) {
+    long i;
+    for (i = 0; i < length && !c->closing; i++) {
+        if (data[i] == '\n') {
+            c->input[c->inputLength] = '\0';
+            session_line(c, c->input, c->overflow);
+            c->inputLength = 0;
+            c->overflow = false;
+        } else if (c->inputLength < MAX_CMD_SIZE) {
+            c->input[c->inputLength++] = data[i];
+        } else {
+            c->overflow = true;
+        }
+    }
+}
+
+/* Sends as much of the queued output as the socket takes, returns false if the connection failed */
+bool session_send(clientSession* c) {
+    ssize_t sent;
+    while (c->outputSent < c->outputLength) {
+        sent = send(c->fd, c->output + c->outputSent, c->outputLength - c->outputSent, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        c->outputSent += sent;
+    }
+    return true;
+}
+
+/* Creates a session for an accepted connection, its random commands follow the server random state */
+clientSession* session_open(int fd) {
+    clientSession* c = calloc(1, sizeof(clientSession));
+    if (c == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    c->fd = fd;
+    c->markErrors = 1;
+    c->mode = 'I';
+    c->countTableMegabytes = COUNT_TABLE_DEFAULT_MB;
+    prng_seed(&c->random, prng_next(&gameRandom));
+    return c;
+}
+
+/* Frees the game of the session and the session */
+void session_free(clientSession* c) {
+    session_enter(c); /* the board is freed with its own dimensions */
+    if (c->mode != 'I' || c->gameOver) {
+        free_board(c->board);
+        free_list(c->movesList);
+    }
+    session_leave(c);
+    free(c->pending);
+    free(c->held);
+    free(c->output);
+    free(c);
+}
+
+/* Closes the connection and frees the session, or stops its command and leaves the session to be freed when the
+ * command ended, as the worker holds it until then */
+void session_close(clientSession* c) {
+    close(c->fd);
+    if (c->running) {
+        c->job.stop = true;
+        c->closed = true;
+    } else {
+        session_free(c);
+    }
+}
+
+/* Creates the listening socket, replacing a stale socket file, returns -1 on failure */
+int listen_socket(const char* path) {
+    struct sockaddr_un address;
+    int fd;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Error: socket path is too long\n");
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+    if ((fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0) {
+        perror("socket");
+        return -1;
+    }
+    unlink(path);
+    if (bind(fd, (struct sockaddr*) &address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        perror(path);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* Raises the open files limit to its maximum, every session holds a descriptor */
+void raise_files_limit() {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+/* Sets the events the loop waits for on the session: reading while nothing is queued, else writing,
+ * so a client which doesn't read its responses is not served more commands, and neither once it closed its side
+ * while its job runs */
+void session_watch(int epollFd, clientSession* c, int operation) {
+    struct epoll_event event;
+    if (c->outputSent < c->outputLength) {
+        event.events = EPOLLOUT;
+    } else {
+        event.events = c->closing ? 0 : EPOLLIN;
+    }
+    event.data.ptr = c;
+    epoll_ctl(epollFd, operation, c->fd, &event);
+}
+
+/* Accepts the pending connections, stops listening while the sessions are at their limit */
+void accept_sessions(int epollFd, int listenFd, long* sessions, long maxSessions, bool* listening) {
+    int fd;
+    while (*sessions < maxSessions) {
+        fd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EMFILE || errno == ENFILE) {
+                break; /* out of descriptors, waiting for a session to close */
+            }
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            return;
+        }
+        session_watch(epollFd, session_open(fd), EPOLL_CTL_ADD);
+        (*sessions)++;
+    }
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, listenFd, NULL);
+    *listening = false;
+}
+
+/* Sends the queued output of the session and sets the events it waits for, returns false when the session should be
+ * closed: the connection failed, or the client is done and its responses are sent */
+bool session_flush(int epollFd, clientSession* c) {
+    if (!session_send(c)) {
+        return false;
+    }
+    if (c->closing && c->outputSent == c->outputLength && !c->running) {
+        return false;
+    }
+    session_watch(epollFd, c, EPOLL_CTL_MOD);
+    return true;
+}
+
+/* Handles the readiness of a session, returns false when the session should be closed */
+bool session_ready(int epollFd, clientSession* c, unsigned int events) {
+    char data[SERVER_READ_SIZE];
+    ssize_t received;
+    if (events & EPOLLIN) {
+        received = recv(c->fd, data, sizeof(data), 0);
+        if (received == 0) { /* the client closed its side, its last line may lack a newline */
+            if (c->inputLength > 0 || c->overflow) {
+                session_receive(c, "\n", 1);
+            }
+            c->closing = true;
+        } else if (received < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                return false;
+            }
+        } else {
+            session_receive(c, data, received);
+        }
+    } else if (events & (EPOLLERR | EPOLLHUP)) {
+        return false;
+    }
+    return session_flush(epollFd, c);
+}
+
+/* Reads a session whose command ended from the pipe and queues the output of the command, then the result of the
+ * cancel or exit which stopped it. returns the session if it should be closed, else NULL */
+clientSession* command_done(int epollFd, int pipeFd) {
+    clientSession* c;
+    FILE* out;
+    char* response = NULL;
+    size_t length = 0;
+    if (read(pipeFd, &c, sizeof(c)) != sizeof(c)) {
+        return NULL; /* read by a previous event already */
+    }
+    c->running = false;
+    if (c->closed) {
+        session_free(c);
+        return NULL;
+    }
+    session_queue(c, c->pending, c->pendingLength);
+    free(c->pending);
+    c->pending = NULL;
+#ifndef SUDOKU_NO_STATS
+    stats_record_command(c->parsedCommand[0], get_time_ns() - c->pendingStart);
+#endif
+    if (c->stopLine > 0) {
+        out = session_stream(&response, &length);
+        commandFailed = false;
+        session_result(c, out, &response, &length, c->stopLine, "cancel", c->stopStart);
+        c->stopLine = 0;
+    }
+    session_resume(c);
+    return session_flush(epollFd, c) ? NULL : c;
+}
+
+/* Parses the server arguments, prints usage message if they are invalid */
+bool parse_serve_args(int argc, char* argv[], long* maxSessions, int* workers) {
+    int i = 3;
+    if (argc < 3) {
+        fprintf(stderr, SERVE_USAGE);
+        return false;
+    }
+    *maxSessions = SERVER_DEFAULT_SESSIONS;
+    *workers = get_cpu_count();
+    while (i < argc) {
+        if (strcmp(argv[i], "--max-sessions") == 0 && i + 1 < argc && is_integer(argv[i + 1])
+            && atol(argv[i + 1]) > 0) {
+            *maxSessions = atol(argv[i + 1]);
+            i += 2;
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc && is_integer(argv[i + 1])
+                   && atoi(argv[i + 1]) > 0) {
+            *workers = atoi(argv[i + 1]);
+            i += 2;
+        } else {
+            fprintf(stderr, SERVE_USAGE);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Starts the workers with SIGINT and SIGTERM blocked, so the signals reach the event loop */
+void start_workers(pthread_t* workers, int count) {
+    sigset_t signals, previous;
+    int i;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, &previous);
+    for (i = 0; i < count; i++) {
+        if (pthread_create(&workers[i], NULL, session_worker, NULL) != 0) {
+            memory_error("Thread creation failed\n");
+            exit(0);
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+}
+
+/* Runs the event loop until a stop signal, then closes every session and removes the socket file */
+int serve(int argc, char* argv[]) {
+    struct epoll_event events[SERVER_EVENTS];
+    struct epoll_event event;
+    struct sigaction action;
+    long maxSessions, sessions = 0;
+    int listenFd, epollFd, ready, i, workerCount;
+    int donePipe[2]; /* the workers write the session of a command which ended to it */
+    pthread_t* workers;
+    bool listening;
+    clientSession* c;
+    if (!parse_serve_args(argc, argv, &maxSessions, &workerCount)) {
+        return 1;
+    }
+    raise_files_limit();
+    if ((listenFd = listen_socket(argv[2])) < 0) {
+        return 1;
+    }
+    if ((epollFd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+        perror("epoll");
+        close(listenFd);
+        return 1;
+    }
+    if (pipe2(donePipe, O_CLOEXEC) != 0) {
+        perror("pipe");
+        close(epollFd);
+        close(listenFd);
+        return 1;
+    }
+    fcntl(donePipe[0], F_SETFL, O_NONBLOCK); /* the workers block on a full pipe until the loop reads it */
+    event.events = EPOLLIN;
+    event.data.ptr = donePipe;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, donePipe[0], &event);
+    commandDoneFd = donePipe[1];
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = stop_server;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    quietMode = true; /* compact responses, boards are printed on request */
+    resultLines = true;
+    serverMode = true;
+    prng_seed(&gameRandom, (unsigned long) time(NULL));
+    queue_initialize(&commandQueue, SERVER_QUEUE_SIZE);
+    workers = malloc(workerCount * sizeof(pthread_t));
+    if (workers == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    start_workers(workers, workerCount);
+    event.events = EPOLLIN;
+    event.data.ptr = NULL; /* the listening socket */
+    listening = (epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) == 0);
+    fprintf(stderr, "Serving on %s with %d workers\n", argv[2], workerCount);
+    while (!serverStop) {
+        ready = epoll_wait(epollFd, events, SERVER_EVENTS, -1);
+        for (i = 0; i < ready; i++) {
+            c = (clientSession*) events[i].data.ptr;
+            if (c == NULL) {
+                accept_sessions(epollFd, listenFd, &sessions, maxSessions, &listening);
+                continue;
+            }
+            if (events[i].data.ptr == (void*) donePipe) {
+                c = command_done(epollFd, donePipe[0]);
+            } else if (session_ready(epollFd, c, events[i].events)) {
+                c = NULL;
+            }
+            if (c != NULL) {
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, c->fd, NULL);
+                session_close(c);
+                sessions--;
+                if (!listening) { /* a session (and its descriptor) is free again */
+                    listening = (epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) == 0);
+                }
+            }
+        }
+    }
+    fprintf(stderr, "Stopping with %ld sessions\n", sessions);
+    queue_close(&commandQueue); /* the idle workers end, the running commands and the sessions end with the process */
+    free(workers);
+    close(epollFd);
+    close(listenFd);
+    unlink(argv[2]);
+    return 0;
+}
@@ -0,0 +1,119 @@
+/** @file server.h
+ *  @brief server header file.
+ *
+ *  This header contains the prototypes for the multi-session server module.
+ *  contains the structure definition of a client session.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_SERVER_H
+#define SUDOKU_SERVER_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include "linked_list.h"
+#include "job.h"
+#include "prng.h"
+#include <stdio.h>
+#include <stddef.h>
+
+
+/* -- Defines -- */
+#define SERVE_USAGE "Usage: sudoku-console --serve <socket> [--max-sessions <count>] [--workers <count>]\n"
+
+#define SERVER_DEFAULT_SESSIONS 10000
+#define SERVER_QUEUE_SIZE 1024 /* commands waiting for a worker, more are rejected until the workers catch up */
+#define SERVER_HELD_LINES 256 /* lines of a session waiting for its running command, more are rejected */
+#define SERVER_READ_SIZE 4096 /* bytes read from a client at a time */
+#define SERVER_EVENTS 256 /* events handled per wait */
+
+
+/* -- Structs -- */
+
+/**
+ * @brief clientSession structure representing the game of one client connection.
+ * clientSession contains fd field, the connection socket.
+ * clientSession contains board, movesList, blockRows, blockCols, markErrors, mode, gameOver, boardHash, random and
+ * countTableMegabytes fields, the game state which the game module keeps in global variables of the thread, swapped in
+ * by the worker running a command of the session.
+ * clientSession contains lineNumber field, the amount of lines received, input and inputLength fields, the current
+ * incomplete line, and overflow field, true while the rest of a line longer than MAX_CMD_SIZE is dropped.
+ * clientSession contains output, outputLength, outputSent and outputCapacity fields, the responses not yet sent.
+ * clientSession contains closing field, true once the client sent exit or closed its side, the session is closed
+ * when its responses are sent.
+ * clientSession contains commandLine, parsedCommand and argsCounter fields, the command the workers run, and running
+ * field, true from the time it is queued until the event loop reads that it ended, the loop leaves the game state to
+ * the worker meanwhile. clientSession contains job field, the job the command may run, and pendingOutput, pending and
+ * pendingLength fields, the stream its output and result line are captured in, with pendingLine and pendingStart
+ * fields, the line and start time of the command.
+ * clientSession contains held, heldLength, heldRead and heldCapacity fields, the lines received while the command
+ * runs with their numbers, run in order when it ended, and heldLines field, their amount.
+ * clientSession contains stopLine and stopStart fields, the line and start time of the cancel which stopped the
+ * running command (stopLine 0 for none), answered after it, and stopping field, true once exit was received while a
+ * command runs, the commands held before it are stopped as well.
+ * clientSession contains closed field, true once the session is closed while its command runs, the session is freed
+ * when the command ends.
+ *
+ */
+typedef struct clientSession {
+    int fd;
+    cell** board;
+    list* movesList;
+    int blockRows;
+    int blockCols;
+    int markErrors;
+    char mode;
+    bool gameOver;
+    unsigned long boardHash;
+    prng random;
+    long countTableMegabytes;
+    int lineNumber;
+    char input[MAX_CMD_SIZE + 2];
+    int inputLength;
+    bool overflow;
+    char* output;
+    size_t outputLength;
+    size_t outputSent;
+    size_t outputCapacity;
+    bool closing;
+    char commandLine[MAX_CMD_SIZE + 2];
+    char* parsedCommand[4];
+    int argsCounter;
+    bool running;
+    commandJob job;
+    FILE* pendingOutput;
+    char* pending;
+    size_t pendingLength;
+    int pendingLine;
+    double pendingStart;
+    char* held;
+    size_t heldLength;
+    size_t heldRead;
+    size_t heldCapacity;
+    int heldLines;
+    int stopLine;
+    double stopStart;
+    bool stopping;
+    bool closed;
+} clientSession;
+
+
+/** @brief Serves games over a Unix domain socket until SIGINT or SIGTERM.
+ *  every connection is a session with its own board, mode and moves list, which reads the commands of the
+ *  interactive game one per line. each non blank line is answered with the output of the command (quiet, boards
+ *  are printed by print_board only) followed by its result line, "ok <line> <command>" or
+ *  "error <line> <command> <message>" as in script mode. the commands run on a fixed pool of worker threads and are
+ *  answered when they end, the next lines of the session wait for them and run in order, cancel stops the running
+ *  command and exit stops the held commands as well. a command which finds the queue of the workers full is rejected.
+ *  exit closes the session.
+ *  @param argc arguments count.
+ *  @param argv arguments, argv[1] is --serve and argv[2] the socket path.
+ *  @return exit code, 0 after a clean shutdown or 1 if the socket could not be served.
+ */
+int serve(int argc, char* argv[]);
+
+
+#endif /*SUDOKU_SERVER_H*/
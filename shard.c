@@ -0,0 +1,289 @@
+/** @file shard.c
+ *  @brief shard source file.
+ *
+ *  This module splits a solutions count too large for one machine into shards which can be counted by separate
+ *  processes, on one machine or on many. The search tree is cut by fixing its first branching decisions, which leaves
+ *  disjoint sub-problems (the frontier). Every shard process counts its share of the frontier and writes a result file,
+ *  and the merge step sums the results:
+ *
+ *      export_frontier count.frontier 64           (interactive command)
+ *      sudoku-console --count-shard count.frontier 0 ... 63
+ *      sudoku-console --merge-shards count.frontier
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "shard.h"
+#include "bit_solver.h"
+#include "count_table.h"
+#include "batch.h"
+#include "main_aux.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+/* -- Defines -- */
+#define FRONTIER_LINE_SIZE (MAX_BOARD_CELLS + 2)
+#define RESULT_PATH_SIZE (MAX_CMD_SIZE + 32) /* a frontier path of up to MAX_CMD_SIZE, a shard number and the suffix */
+
+
+/* Appends a sub-problem to the list, growing it when full */
+void add_subproblem(char*** problems, long* count, long* capacity, const char* line) {
+    if (*count == *capacity) {
+        *capacity *= 2;
+        *problems = realloc(*problems, *capacity * sizeof(char*));
+        if (*problems == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+    }
+    (*problems)[*count] = malloc(strlen(line) + 1);
+    if ((*problems)[*count] == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    strcpy((*problems)[*count], line);
+    (*count)++;
+}
+
+/* Expands the sub-problems breadth first: the first open one is replaced by one sub-problem per candidate of its
+ * branching cell. solutions are set aside as sub-problems of their own and dead ends are dropped */
+long export_frontier(bitSolver* s, const char* path, int shards) {
+    char line[FRONTIER_LINE_SIZE];
+    char** problems;
+    char** solved;
+    long count = 0, capacity = 64, first = 0, solvedCount = 0, solvedCapacity = 64, i, total;
+    int idx, rows = s->blockRows, cols = s->blockCols;
+    unsigned long mask, bit;
+    bitSolver* expand;
+    FILE* fp;
+    problems = malloc(capacity * sizeof(char*));
+    solved = malloc(solvedCapacity * sizeof(char*));
+    expand = malloc(sizeof(bitSolver));
+    if (problems == NULL || solved == NULL || expand == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    bit_format_string(s, line);
+    add_subproblem(&problems, &count, &capacity, line);
+    while (count - first + solvedCount < shards && first < count) {
+        bit_load_string(expand, problems[first], rows, cols);
+        mask = bit_branch(expand, &idx);
+        if (idx == -1) {
+            add_subproblem(&solved, &solvedCount, &solvedCapacity, problems[first]);
+        }
+        free(problems[first]);
+        first++;
+        for (; mask != 0; mask &= ~bit) {
+            bit = mask & (~mask + 1);
+            bit_place(expand, idx, lowest_bit_index(bit) + 1);
+            bit_format_string(expand, line);
+            bit_remove(expand, idx);
+            add_subproblem(&problems, &count, &capacity, line);
+        }
+    }
+    total = count - first + solvedCount;
+    if ((fp = fopen(path, "w")) != NULL) {
+        fprintf(fp, "sudoku-frontier %d %d %d %ld\n", rows, cols, shards, total);
+        for (i = 0; i < total; i++) {
+            fprintf(fp, "%ld %s\n", i % shards, (i < solvedCount) ? solved[i] : problems[first + i - solvedCount]);
+        }
+        if (fclose(fp) != 0) {
+            fp = NULL;
+        }
+    }
+    for (i = first; i < count; i++) {
+        free(problems[i]);
+    }
+    for (i = 0; i < solvedCount; i++) {
+        free(solved[i]);
+    }
+    free(problems);
+    free(solved);
+    free(expand);
+    return (fp == NULL) ? -1 : total;
+}
+
+/* Parses shard counting arguments, prints usage message if they are invalid */
+bool parse_shard_args(int argc, char* argv[], batchOptions* options) {
+    int i = 4;
+    if (argc < 4 || !is_integer(argv[3]) || atol(argv[3]) < 0) {
+        fprintf(stderr, SHARD_USAGE);
+        return false;
+    }
+    options->corpusPath = argv[2];
+    options->outputPath = NULL;
+    options->task = 'K';
+    options->blockRows = 0;
+    options->blockCols = 0;
+    options->threads = 1;
+    options->count = atol(argv[3]);
+    options->clues = 0;
+    options->seed = 0;
+    options->symmetric = false;
+    options->solutions = false;
+    options->grade = false;
+    while (i < argc) {
+        if ((strcmp(argv[i], "--output") == 0 || strcmp(argv[i], "-o") == 0) && i + 1 < argc) {
+            options->outputPath = argv[i + 1];
+            i += 2;
+        } else {
+            fprintf(stderr, SHARD_USAGE);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Reads the frontier header, returns false if it isn't a frontier file */
+bool read_frontier_header(FILE* fp, int* rows, int* cols, int* shards, long* problems) {
+    return fscanf(fp, "sudoku-frontier %d %d %d %ld", rows, cols, shards, problems) == 4
+           && *shards >= 1 && *shards <= FRONTIER_MAX_SHARDS && *problems >= 0;
+}
+
+/* Writes the default result path of a shard, returns false if the frontier path is too long for it */
+bool shard_result_path(char* resultPath, const char* frontierPath, long shard) {
+    if (strlen(frontierPath) > MAX_CMD_SIZE) {
+        fprintf(stderr, "Error: frontier path is too long, at most %d characters\n", MAX_CMD_SIZE);
+        return false;
+    }
+    sprintf(resultPath, "%s.%ld%s", frontierPath, shard, SHARD_RESULT_SUFFIX);
+    return true;
+}
+
+/* Counts a sub-problem like num_solutions: up to relabeling of its free digits, with the transposition table,
+ * saturating at LONG_MAX */
+long count_subproblem(bitSolver* s, countTable* table, long* nodes) {
+    long solutions = 0, orbit = 1;
+    int freeDigits;
+    bit_search_begin(s);
+    for (freeDigits = bit_search_canonical(s); freeDigits > 1; freeDigits--) {
+        orbit = bit_count_add(0, orbit, freeDigits);
+    }
+    s->table = table;
+    while (bit_search_next(s) == SEARCH_FOUND) {
+        solutions = bit_count_add(solutions, orbit, s->found);
+    }
+    *nodes += s->nodes;
+    s->table = NULL;
+    return solutions;
+}
+
+/* Counts the sub-problems of the shard, sharing one transposition table between them since residual states
+ * don't depend on the sub-problem they come from */
+int count_shard(batchOptions* options) {
+    char line[FRONTIER_LINE_SIZE];
+    char resultPath[RESULT_PATH_SIZE];
+    int rows, cols, shards;
+    long problems, shard, mine = 0, solutions = 0, nodes = 0;
+    double start = get_time_ns();
+    bitSolver* s;
+    countTable* table;
+    FILE* fp;
+    if (options->outputPath == NULL && !shard_result_path(resultPath, options->corpusPath, options->count)) {
+        return 1;
+    }
+    if ((fp = fopen(options->corpusPath, "r")) == NULL) {
+        fprintf(stderr, "Error: File doesn't exist or cannot be opened\n");
+        return 1;
+    }
+    if (!read_frontier_header(fp, &rows, &cols, &shards, &problems) || options->count >= shards) {
+        fprintf(stderr, "Error: %s is not a frontier file or has no shard %ld\n", options->corpusPath, options->count);
+        fclose(fp);
+        return 1;
+    }
+    s = malloc(sizeof(bitSolver));
+    table = malloc(sizeof(countTable));
+    if (s == NULL || table == NULL) {
+        memory_error("Memory allocation failed\n");
+        exit(0);
+    }
+    count_table_init(table, countTableMegabytes);
+    while (fscanf(fp, "%ld %1025s", &shard, line) == 2) {
+        if (shard != options->count) {
+            continue;
+        }
+        if (!bit_load_string(s, line, rows, cols)) {
+            fprintf(stderr, "Error: invalid sub-problem in %s\n", options->corpusPath);
+            fclose(fp);
+            count_table_free(table);
+            free(table);
+            free(s);
+            return 1;
+        }
+        solutions = bit_count_add(solutions, 1, count_subproblem(s, table, &nodes));
+        mine++;
+    }
+    fclose(fp);
+    count_table_free(table);
+    free(table);
+    free(s);
+    if ((fp = fopen((options->outputPath != NULL) ? options->outputPath : resultPath, "w")) == NULL) {
+        fprintf(stderr, "Error: File cannot be created or modified\n");
+        return 1;
+    }
+    fprintf(fp, "sudoku-shard %ld %d %ld %ld %ld\n", options->count, shards, mine, solutions, nodes);
+    if (fclose(fp) != 0) {
+        fprintf(stderr, "Error: File cannot be created or modified\n");
+        return 1;
+    }
+    fprintf(stderr, "Shard %ld of %d: %ld sub-problems, %ld solutions, %ld nodes in %.2f seconds\n",
+            options->count, shards, mine, solutions, nodes, (get_time_ns() - start) / 1e9);
+    return 0;
+}
+
+/* Reads the result of every shard from its default path and sums them, a sum which doesn't fit a long is LONG_MAX */
+int merge_shards(int argc, char* argv[]) {
+    char resultPath[RESULT_PATH_SIZE];
+    int rows, cols, shards, i, resultShards;
+    long problems, resultShard, mine, count, nodes, totalProblems = 0, solutions = 0, totalNodes = 0;
+    FILE* fp;
+    if (argc != 3) {
+        fprintf(stderr, MERGE_USAGE);
+        return 1;
+    }
+    if ((fp = fopen(argv[2], "r")) == NULL) {
+        fprintf(stderr, "Error: File doesn't exist or cannot be opened\n");
+        return 1;
+    }
+    if (!read_frontier_header(fp, &rows, &cols, &shards, &problems)) {
+        fprintf(stderr, "Error: %s is not a frontier file\n", argv[2]);
+        fclose(fp);
+        return 1;
+    }
+    fclose(fp);
+    for (i = 0; i < shards; i++) {
+        if (!shard_result_path(resultPath, argv[2], i)) {
+            return 1;
+        }
+        if ((fp = fopen(resultPath, "r")) == NULL) {
+            fprintf(stderr, "Error: result of shard %d is missing (%s)\n", i, resultPath);
+            return 1;
+        }
+        if (fscanf(fp, "sudoku-shard %ld %d %ld %ld %ld", &resultShard, &resultShards, &mine, &count, &nodes) != 5
+            || resultShard != i || resultShards != shards || count < 0) {
+            fprintf(stderr, "Error: %s is not a result of shard %d of this frontier\n", resultPath, i);
+            fclose(fp);
+            return 1;
+        }
+        fclose(fp);
+        totalProblems += mine;
+        solutions = bit_count_add(solutions, 1, count);
+        totalNodes += nodes;
+    }
+    if (totalProblems != problems) {
+        fprintf(stderr, "Error: the shards counted %ld of %ld sub-problems\n", totalProblems, problems);
+        return 1;
+    }
+    if (solutions == LONG_MAX) {
+        printf("Number of solutions: more than %ld, too many to count exactly\n", LONG_MAX - 1);
+    } else {
+        printf("Number of solutions: %ld\n", solutions);
+    }
+    printf("Shards: %d, sub-problems: %ld, nodes: %ld\n", shards, problems, totalNodes);
+    return 0;
+}
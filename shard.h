@@ -0,0 +1,66 @@
+/** @file shard.h
+ *  @brief shard header file.
+ *
+ *  This header contains the prototypes for the sharded counting module.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_SHARD_H
+#define SUDOKU_SHARD_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include "bit_solver.h"
+#include "batch.h"
+
+
+/* -- Defines -- */
+#define SHARD_USAGE "Usage: sudoku-console --count-shard <frontier> <shard> [--output <file>]\n"
+
+#define MERGE_USAGE "Usage: sudoku-console --merge-shards <frontier>\n"
+
+#define FRONTIER_MAX_SHARDS 65536
+#define SHARD_RESULT_SUFFIX ".result" /* shard i of frontier f writes f.i.result unless told otherwise */
+
+
+/** @brief Splits the search of the board in given search context into disjoint sub-problems by fixing its first
+ *  branching decisions, breadth first, until there are at least shards of them (or the tree is exhausted),
+ *  and writes them to a frontier file, dealt round robin into shards.
+ *  the solutions of the board are exactly the solutions of the sub-problems, each counted once.
+ *  @param s search context holding the board, not searching.
+ *  @param path frontier file path.
+ *  @param shards amount of shards, 1-FRONTIER_MAX_SHARDS.
+ *  @return the amount of sub-problems written, or -1 if the file could not be written.
+ */
+long export_frontier(bitSolver* s, const char* path, int shards);
+
+
+/** @brief Parses shard counting arguments, prints usage message if they are invalid.
+ *  shard counting ('K' task) uses corpusPath for the frontier, count for the shard and outputPath for the result.
+ *  @param argc arguments count.
+ *  @param argv arguments, argv[1] is --count-shard.
+ *  @param options to be updated with the parsed options.
+ *  @return true if the arguments are valid, else false.
+ */
+bool parse_shard_args(int argc, char* argv[], batchOptions* options);
+
+
+/** @brief Counts the solutions of the sub-problems of one shard of a frontier and writes them to a result file.
+ *  @param options shard counting options.
+ *  @return exit code, 0 on success.
+ */
+int count_shard(batchOptions* options);
+
+
+/** @brief Sums the result files of every shard of a frontier and prints the number of solutions of its board.
+ *  @param argc arguments count.
+ *  @param argv arguments, argv[1] is --merge-shards and argv[2] the frontier.
+ *  @return exit code, 0 on success or 1 if a result is missing or doesn't belong to the frontier.
+ */
+int merge_shards(int argc, char* argv[]);
+
+
+#endif /*SUDOKU_SHARD_H*/
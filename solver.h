@@ -1,56 +1,75 @@
-/** @file solver.h
- *  @brief solver header file.
- *
- *  This header contains the prototypes for the solver module.
- *
- *  @author Itay Keren (itaykeren)
- *  @author Rotem Bar (rotembar)
- *
- */
-#ifndef SUDOKU_SOLVER_H
-#define SUDOKU_SOLVER_H
-
-
-/* -- Includes -- */
-
-#include "main_aux.h"
-#include <time.h>
-
-
-/**
- *  @brief Duplicates sudoku board.
- *  @param oldBoard - board to duplicate.
- *  @return Duplicated sudoku board.
- */
-cell** duplicate_board(cell** oldBoard);
-
-
-/**
- *  @brief Checks if sudoku board is feasible using ILP.
- *  @param b - Board to validate.
- *  @param solvedBoard - Copy of board.
- *  @return 1 if feasible, else 0.
- */
-int ILP(cell **b, cell **solvedBoard);
-
-
-/**
- *  @brief Counts number of solutions to sudoku board using deterministic backtrack.
- *  @param board - Board to count solutions to.
- *  @param i - Rows index.
- *  @param j - Columns index.
- *  @return Number of solutions.
- */
-int deterministic_backtrack(cell** board, int i, int j);
-
-
-/**
- *  @brief Randomly chooses given number of cells and unassign them.
- *  @param solvedBoard - Board to assign values to.
- *  @param copyCells - Number of cells.
- *  @param finalBoard - Board which will contain the assigned valued at the end of the function.
- *  @return void.
- */
-void copy_random_cells(cell **solvedBoard, int copyCells, cell** finalBoard);
-
-#endif /*SUDOKU_SOLVER_H*/
+/** @file solver.h
+ *  @brief solver header file.
+ *
+ *  This header contains the prototypes for the solver module.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+#ifndef SUDOKU_SOLVER_H
+#define SUDOKU_SOLVER_H
+
+
+/* -- Includes -- */
+
+#include "main_aux.h"
+#include <time.h>
+
+
+/* -- Structs -- */
+
+/**
+ * @brief countBudget structure representing the limits of a solutions count and how much of the search it covered.
+ * countBudget contains maxNodes field and maxMs field, the node and wall-clock budgets (0 for no limit).
+ * countBudget contains nodes field counting the search nodes visited and explored field containing the fraction
+ * of the search tree covered, where every branch of a node weighs the same share of its parent.
+ * countBudget contains exhausted field, true if a budget stopped the count (the count is then a lower bound).
+ */
+typedef struct countBudget {
+    long maxNodes;
+    long maxMs;
+    long nodes;
+    double explored;
+    bool exhausted;
+} countBudget;
+
+
+/**
+ *  @brief Duplicates sudoku board.
+ *  @param oldBoard - board to duplicate.
+ *  @return Duplicated sudoku board.
+ */
+cell** duplicate_board(cell** oldBoard);
+
+
+/**
+ *  @brief Checks if sudoku board is feasible using ILP.
+ *  @param b - Board to validate.
+ *  @param solvedBoard - Copy of board.
+ *  @return 1 if feasible, else 0.
+ */
+int ILP(cell **b, cell **solvedBoard);
+
+
+/**
+ *  @brief Counts number of solutions to sudoku board using deterministic backtrack.
+ *  @param board - Board to count solutions to.
+ *  @param i - Rows index.
+ *  @param j - Columns index.
+ *  @param budget - Search budgets, updated with the nodes visited and the explored fraction, may be NULL.
+ *  @return Number of solutions, a lower bound when a budget was exhausted.
+ */
+int deterministic_backtrack(cell** board, int i, int j, countBudget* budget);
+
+
+/**
+ *  @brief Randomly chooses given number of distinct cells and copies their values to finalBoard.
+ *  @param solvedBoard - Board to copy values from.
+ *  @param copyCells - Number of cells.
+ *  @param finalBoard - Board which will contain the assigned valued at the end of the function.
+ *  @return void.
+ */
+void copy_random_cells(cell **solvedBoard, int copyCells, cell** finalBoard);
+
+#endif /*SUDOKU_SOLVER_H*/
@@ -0,0 +1,153 @@
+/** @file stats.c
+ *  @brief stats source file.
+ *
+ *  This module keeps the instrumentation of the process: counters updated on the hot paths with one atomic add,
+ *  and a log-linear latency histogram per command of the command language, allocated on first use and guarded by a
+ *  lock, as the server records the latencies on its event loop while a worker may print them.
+ *  The search adds its counters once per call of bit_search_next rather than once per node.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "stats.h"
+#include "histogram.h"
+#include "main_aux.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* -- Defines -- */
+#define STATS_OTHER "other"
+#define STATS_COMMANDS ((int) (sizeof(statsCommandNames) / sizeof(statsCommandNames[0])))
+
+
+/* -- Global Variables  -- */
+statsCounters counters;
+
+#ifndef SUDOKU_NO_STATS
+
+const char* const statsCommandNames[] = {"solve", "edit", "generate_from", "set", "hint", "validate", "print_board",
+                                         "mark_errors", "autofill", "save", "num_solutions", "enumerate",
+                                         "export_frontier", "count_table", "estimate_solutions", "grade", "generate",
+                                         "generate_unique", "undo", "redo", "reset", "speculate", "seed", "cancel",
+                                         "stats", STATS_OTHER};
+histogram* commandLatency[STATS_COMMANDS];
+pthread_mutex_t statsLock = PTHREAD_MUTEX_INITIALIZER; /* guards the histograms */
+const char* statsPath = NULL;
+
+
+/* Reads a counter which other threads may be updating */
+long stats_read(long* counter) {
+#ifdef __GNUC__
+    return __sync_fetch_and_add(counter, 0);
+#else
+    return *counter;
+#endif
+}
+
+/* Records the latency in the histogram of the command, allocating it on the first record */
+void stats_record_command(const char* name, double ns) {
+    int i;
+    for (i = 0; i < STATS_COMMANDS - 1 && strcmp(statsCommandNames[i], name) != 0; i++);
+    pthread_mutex_lock(&statsLock);
+    if (commandLatency[i] == NULL) {
+        commandLatency[i] = malloc(sizeof(histogram));
+        if (commandLatency[i] == NULL) {
+            memory_error("Memory allocation failed\n");
+            exit(0);
+        }
+        histogram_reset(commandLatency[i]);
+    }
+    histogram_record(commandLatency[i], ns);
+    pthread_mutex_unlock(&statsLock);
+}
+
+/* Prints the counters and a line of latency percentiles in microseconds per command */
+void stats_command(bool json) {
+    int i;
+    histogram* h;
+    if (json) {
+        stats_write_json(commandOutput);
+        return;
+    }
+    fprintf(commandOutput, "Search nodes: %ld\n", stats_read(&counters.searchNodes));
+    fprintf(commandOutput, "Backtracks: %ld\n", stats_read(&counters.backtracks));
+    fprintf(commandOutput, "Eliminations: %ld\n", stats_read(&counters.eliminations));
+    fprintf(commandOutput, "ILP calls: %ld (%.3f ms)\n", stats_read(&counters.ilpCalls),
+            stats_read(&counters.ilpMicros) / 1000.0);
+    fprintf(commandOutput, "Board allocations: %ld\n", stats_read(&counters.boardAllocations));
+    fprintf(commandOutput, "History bytes: %ld\n", stats_read(&counters.historyBytes));
+    fprintf(commandOutput, "Command latency (us): count p50 p90 p99 max\n");
+    pthread_mutex_lock(&statsLock);
+    for (i = 0; i < STATS_COMMANDS; i++) {
+        if ((h = commandLatency[i]) != NULL) {
+            fprintf(commandOutput, "  %s: %lu %.1f %.1f %.1f %.1f\n", statsCommandNames[i], h->total,
+                    histogram_percentile(h, 50) / 1000, histogram_percentile(h, 90) / 1000,
+                    histogram_percentile(h, 99) / 1000, h->max / 1000);
+        }
+    }
+    pthread_mutex_unlock(&statsLock);
+}
+
+/* Writes the latency histogram of a command: its summary and the upper bound and count of its non empty buckets */
+void write_latency_json(FILE* fp, const char* name, histogram* h) {
+    int bucket;
+    bool first = true;
+    fprintf(fp, "\"%s\":{\"count\":%lu,\"mean_ns\":%.0f,\"min_ns\":%.0f,\"p50_ns\":%.0f,\"p90_ns\":%.0f,"
+                "\"p99_ns\":%.0f,\"p999_ns\":%.0f,\"max_ns\":%.0f,\"buckets\":[", name, h->total, h->sum / h->total,
+            h->min, histogram_percentile(h, 50), histogram_percentile(h, 90), histogram_percentile(h, 99),
+            histogram_percentile(h, 99.9), h->max);
+    for (bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        if (h->counts[bucket] > 0) {
+            fprintf(fp, "%s[%.0f,%lu]", first ? "" : ",", histogram_bucket_bound(bucket), h->counts[bucket]);
+            first = false;
+        }
+    }
+    fprintf(fp, "]}");
+}
+
+/* Writes the statistics as one JSON object */
+void stats_write_json(FILE* fp) {
+    int i;
+    bool first = true;
+    fprintf(fp, "{\"counters\":{\"search_nodes\":%ld,\"backtracks\":%ld,\"eliminations\":%ld,\"ilp_calls\":%ld,"
+                "\"ilp_us\":%ld,\"board_allocations\":%ld,\"history_bytes\":%ld},\"commands\":{",
+            stats_read(&counters.searchNodes), stats_read(&counters.backtracks), stats_read(&counters.eliminations),
+            stats_read(&counters.ilpCalls), stats_read(&counters.ilpMicros), stats_read(&counters.boardAllocations),
+            stats_read(&counters.historyBytes));
+    pthread_mutex_lock(&statsLock);
+    for (i = 0; i < STATS_COMMANDS; i++) {
+        if (commandLatency[i] != NULL) {
+            fprintf(fp, "%s", first ? "" : ",");
+            write_latency_json(fp, statsCommandNames[i], commandLatency[i]);
+            first = false;
+        }
+    }
+    pthread_mutex_unlock(&statsLock);
+    fprintf(fp, "}}\n");
+}
+
+/* atexit() handler writing the statistics file */
+void write_stats_file() {
+    FILE* fp;
+    if ((fp = fopen(statsPath, "w")) == NULL) {
+        fprintf(stderr, "Error: statistics file %s cannot be created or modified\n", statsPath);
+        return;
+    }
+    stats_write_json(fp);
+    fclose(fp);
+}
+
+/* Registers the exit handler once */
+void stats_dump_at_exit(const char* path) {
+    if (statsPath == NULL) {
+        atexit(write_stats_file);
+    }
+    statsPath = path;
+}
+
+#endif
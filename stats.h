@@ -0,0 +1,93 @@
+/** @file stats.h
+ *  @brief stats header file.
+ *
+ *  This header contains the prototypes for the instrumentation module.
+ *  contains the structure definition of the process wide counters and the macros which update them.
+ *  building with SUDOKU_NO_STATS defined turns the macros into nothing and removes the stats command,
+ *  the --stats option and the per command latency histograms.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_STATS_H
+#define SUDOKU_STATS_H
+
+/* -- Includes -- */
+#include "main_aux.h"
+#include <stdio.h>
+
+
+/* -- Defines -- */
+#ifdef SUDOKU_NO_STATS
+#define STATS_ADD(counter, amount) ((void) 0)
+#elif defined(__GNUC__)
+#define STATS_ADD(counter, amount) ((void) __sync_fetch_and_add(&counters.counter, (long) (amount)))
+#else
+#define STATS_ADD(counter, amount) ((void) (counters.counter += (long) (amount)))
+#endif
+#define STATS_INC(counter) STATS_ADD(counter, 1)
+
+
+/* -- Structs -- */
+
+/**
+ * @brief statsCounters structure representing the counters of the process, updated by every thread.
+ * statsCounters contains searchNodes, backtracks and eliminations fields: the nodes of the bitmask search,
+ * the levels it exhausted, and the candidates its hidden singles ruled out.
+ * statsCounters contains ilpCalls and ilpMicros fields, the ILP solver invocations and their total time.
+ * statsCounters contains boardAllocations field, the sudoku boards allocated,
+ * and historyBytes field, the memory currently held by moves lists.
+ *
+ */
+typedef struct statsCounters {
+    long searchNodes;
+    long backtracks;
+    long eliminations;
+    long ilpCalls;
+    long ilpMicros;
+    long boardAllocations;
+    long historyBytes;
+} statsCounters;
+
+
+/* -- Global Variables  -- */
+extern statsCounters counters;
+
+
+#ifndef SUDOKU_NO_STATS
+
+/** @brief Records the latency of a command in the histogram of its name.
+ *  commands outside the command language are recorded as "other".
+ *  @param name first word of the command.
+ *  @param ns latency in nanoseconds.
+ *  @return void.
+ */
+void stats_record_command(const char* name, double ns);
+
+
+/** @brief Prints the counters and the latency percentiles of every command, even in quiet mode.
+ *  @param json true to print a JSON object, else a table.
+ *  @return void.
+ */
+void stats_command(bool json);
+
+
+/** @brief Writes the counters and the latency histograms of every command as a JSON object.
+ *  @param fp file opened for writing.
+ *  @return void.
+ */
+void stats_write_json(FILE* fp);
+
+
+/** @brief Writes the statistics as JSON to given file when the process exits.
+ *  @param path file path, kept by reference.
+ *  @return void.
+ */
+void stats_dump_at_exit(const char* path);
+
+#endif
+
+
+#endif /*SUDOKU_STATS_H*/
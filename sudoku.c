@@ -0,0 +1,355 @@
+/** @file sudoku.c
+ *  @brief sudoku source file.
+ *
+ *  This module implements the public API of libsudoku on top of the self contained search contexts of the bit solver
+ *  and the generator, which use no global state. A context keeps the board values apart from its search context,
+ *  since the board may hold erroneous values which a search context can't, and loads them into the search context
+ *  for every solve, count or generate. Board files are read and written by the board file module and the moves
+ *  are kept by the history module, which the game uses as well.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+/* -- Includes -- */
+#include "sudoku.h"
+#include "main_aux.h"
+#include "bit_solver.h"
+#include "generator.h"
+#include "history.h"
+#include "board_file.h"
+#include "prng.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* -- Structs -- */
+
+/**
+ * @brief sudokuContext structure representing a board of the library.
+ * sudokuContext contains blockRows, blockCols, N and size fields describing the board dimensions (size = N * N).
+ * sudokuContext contains values field, the cell values in row-major order, and fixed field, true for fixed cells.
+ * sudokuContext contains moves field, the history of the moves made since the board was loaded.
+ * sudokuContext contains solver field, the search context of solve, count and generate, whose generator is the
+ * random generator of the context.
+ *
+ */
+struct sudokuContext {
+    int blockRows;
+    int blockCols;
+    int N;
+    int size;
+    int values[MAX_BOARD_CELLS];
+    bool fixed[MAX_BOARD_CELLS];
+    history moves;
+    bitSolver solver;
+};
+
+
+/* Sets the dimensions and empties the board and the history */
+static void clear_context(sudokuContext* ctx, int blockRows, int blockCols) {
+    ctx->blockRows = blockRows;
+    ctx->blockCols = blockCols;
+    ctx->N = blockRows * blockCols;
+    ctx->size = ctx->N * ctx->N;
+    memset(ctx->values, 0, sizeof(ctx->values));
+    memset(ctx->fixed, 0, sizeof(ctx->fixed));
+    history_clear(&ctx->moves);
+}
+
+/* Creates the context, its history grows with the moves */
+int sudoku_create(sudokuContext** ctx, int blockRows, int blockCols, unsigned long seed) {
+    if (blockRows < 1 || blockCols < 1 || blockRows * blockCols > MAX_BOARD_SIZE) {
+        return SUDOKU_ERROR_ARGUMENT;
+    }
+    *ctx = malloc(sizeof(sudokuContext));
+    if (*ctx == NULL) {
+        return SUDOKU_ERROR_MEMORY;
+    }
+    history_init(&(*ctx)->moves);
+    clear_context(*ctx, blockRows, blockCols);
+    prng_seed(&(*ctx)->solver.rng, seed);
+    return SUDOKU_OK;
+}
+
+/* Frees the history and the context */
+void sudoku_destroy(sudokuContext* ctx) {
+    if (ctx != NULL) {
+        history_free(&ctx->moves);
+        free(ctx);
+    }
+}
+
+/* Returns the block dimensions */
+void sudoku_dimensions(const sudokuContext* ctx, int* blockRows, int* blockCols) {
+    *blockRows = ctx->blockRows;
+    *blockCols = ctx->blockCols;
+}
+
+/* Reads a board file which fits a context into the given arrays, returns SUDOKU_OK when the whole board was read */
+static int read_board_file(FILE* fp, int* blockRows, int* blockCols, int* values, bool* fixed) {
+    int idx, N;
+    char mark;
+    if (!board_file_read_header(fp, MAX_BOARD_SIZE, blockRows, blockCols)) {
+        return SUDOKU_ERROR_FORMAT;
+    }
+    N = *blockRows * *blockCols;
+    for (idx = 0; idx < N * N; idx++) {
+        if (!board_file_read_cell(fp, N, &values[idx], &mark)) {
+            return SUDOKU_ERROR_FORMAT;
+        }
+        fixed[idx] = (mark == '.' && values[idx] != UNASSIGNED);
+    }
+    return SUDOKU_OK;
+}
+
+/* Loads the board file into temporary arrays and keeps them once the whole board was read */
+int sudoku_load(sudokuContext* ctx, const char* path) {
+    int values[MAX_BOARD_CELLS];
+    bool fixed[MAX_BOARD_CELLS];
+    int blockRows, blockCols, outcome;
+    FILE* fp;
+    if ((fp = fopen(path, "r")) == NULL) {
+        return SUDOKU_ERROR_FILE;
+    }
+    outcome = read_board_file(fp, &blockRows, &blockCols, values, fixed);
+    fclose(fp);
+    if (outcome != SUDOKU_OK) {
+        return outcome;
+    }
+    clear_context(ctx, blockRows, blockCols);
+    memcpy(ctx->values, values, ctx->size * sizeof(int));
+    memcpy(ctx->fixed, fixed, ctx->size * sizeof(bool));
+    return SUDOKU_OK;
+}
+
+/* Loads the line with the search context, which checks the symbols and conflicts */
+int sudoku_load_string(sudokuContext* ctx, const char* line) {
+    bitSolver* s = &ctx->solver;
+    int idx;
+    if (!bit_load_string(s, line, 0, 0)) {
+        return SUDOKU_ERROR_FORMAT;
+    }
+    clear_context(ctx, s->blockRows, s->blockCols);
+    for (idx = 0; idx < ctx->size; idx++) {
+        ctx->values[idx] = s->grid[idx];
+        ctx->fixed[idx] = (s->grid[idx] != UNASSIGNED);
+    }
+    return SUDOKU_OK;
+}
+
+/* Saves the board like the save command of solve mode, fixed cells are marked with '.' */
+int sudoku_save(const sudokuContext* ctx, const char* path) {
+    FILE* fp;
+    int idx;
+    bool ok;
+    if ((fp = fopen(path, "w")) == NULL) {
+        return SUDOKU_ERROR_FILE;
+    }
+    ok = board_file_write_header(fp, ctx->blockRows, ctx->blockCols);
+    for (idx = 0; idx < ctx->size && ok; idx++) {
+        ok = board_file_write_cell(fp, ctx->values[idx], ctx->fixed[idx], idx % ctx->N == ctx->N - 1);
+    }
+    ok = (fclose(fp) == 0) && ok;
+    return ok ? SUDOKU_OK : SUDOKU_ERROR_FILE;
+}
+
+/* Writes the one-line representation of the board */
+int sudoku_format(const sudokuContext* ctx, char* out, size_t size) {
+    if (size < (size_t) ctx->size + 1) {
+        return SUDOKU_ERROR_ARGUMENT;
+    }
+    bit_format_values(ctx->values, ctx->size, out);
+    out[ctx->size] = '\0';
+    return SUDOKU_OK;
+}
+
+/* Returns the index of the cell, or -1 if the column or row is out of range */
+static int cell_index(const sudokuContext* ctx, int column, int row) {
+    if (column < 1 || column > ctx->N || row < 1 || row > ctx->N) {
+        return -1;
+    }
+    return (row - 1) * ctx->N + (column - 1);
+}
+
+/* Reads the value of a cell */
+int sudoku_get(const sudokuContext* ctx, int column, int row, int* value) {
+    int idx = cell_index(ctx, column, row);
+    if (idx < 0) {
+        return SUDOKU_ERROR_ARGUMENT;
+    }
+    *value = ctx->values[idx];
+    return SUDOKU_OK;
+}
+
+/* Applies a change of the move numbered step and records it, the room was reserved */
+static void record_change(sudokuContext* ctx, int idx, int value, int step) {
+    history_record(&ctx->moves, idx, ctx->values[idx], value, step);
+    ctx->values[idx] = value;
+}
+
+/* Sets a cell as a move of its own */
+int sudoku_set(sudokuContext* ctx, int column, int row, int value) {
+    int idx = cell_index(ctx, column, row);
+    if (idx < 0 || value < 0 || value > ctx->N) {
+        return SUDOKU_ERROR_ARGUMENT;
+    }
+    if (ctx->fixed[idx]) {
+        return SUDOKU_ERROR_FIXED;
+    }
+    if (!history_reserve(&ctx->moves, 1)) {
+        return SUDOKU_ERROR_MEMORY;
+    }
+    record_change(ctx, idx, value, history_next_step(&ctx->moves));
+    return SUDOKU_OK;
+}
+
+/* Restores the values before the changes of the last applied move */
+int sudoku_undo(sudokuContext* ctx) {
+    historyChange* change;
+    int first, last;
+    if (!history_undo(&ctx->moves, &first, &last)) {
+        return SUDOKU_ERROR_HISTORY;
+    }
+    while (last > first) {
+        change = &ctx->moves.changes[--last];
+        ctx->values[change->idx] = change->before;
+    }
+    return SUDOKU_OK;
+}
+
+/* Applies again the changes of the first undone move */
+int sudoku_redo(sudokuContext* ctx) {
+    historyChange* change;
+    int first, last;
+    if (!history_redo(&ctx->moves, &first, &last)) {
+        return SUDOKU_ERROR_HISTORY;
+    }
+    while (first < last) {
+        change = &ctx->moves.changes[first++];
+        ctx->values[change->idx] = change->after;
+    }
+    return SUDOKU_OK;
+}
+
+/* Loads the board values into the search context, returns false if a value conflicts with another */
+static bool load_solver(sudokuContext* ctx) {
+    bitSolver* s = &ctx->solver;
+    int idx, val;
+    bit_init(s, ctx->blockRows, ctx->blockCols);
+    for (idx = 0; idx < ctx->size; idx++) {
+        val = ctx->values[idx];
+        if (val != UNASSIGNED) {
+            if ((bit_candidates(s, idx) & (1UL << (val - 1))) == 0) {
+                return false;
+            }
+            bit_place(s, idx, val);
+        }
+    }
+    return true;
+}
+
+/* Solves the board with the search context and fills the empty cells as one move */
+int sudoku_solve(sudokuContext* ctx) {
+    bitSolver* s = &ctx->solver;
+    int idx, step;
+    if (!load_solver(ctx)) {
+        return SUDOKU_ERROR_ERRONEOUS;
+    }
+    if (!bit_solve(s)) {
+        return SUDOKU_ERROR_UNSOLVABLE;
+    }
+    if (!history_reserve(&ctx->moves, ctx->size)) {
+        return SUDOKU_ERROR_MEMORY;
+    }
+    step = history_next_step(&ctx->moves);
+    for (idx = 0; idx < ctx->size; idx++) {
+        if (ctx->values[idx] == UNASSIGNED) {
+            record_change(ctx, idx, s->grid[idx], step);
+        }
+    }
+    return SUDOKU_OK;
+}
+
+/* Counts the solutions up to relabeling of the free digits, like num_solutions, within the nodes budget.
+ * a count which doesn't fit a long saturates at LONG_MAX and the search stops there */
+int sudoku_count(sudokuContext* ctx, long maxNodes, long* solutions) {
+    bitSolver* s = &ctx->solver;
+    long orbit = 1;
+    int freeDigits, status;
+    *solutions = 0;
+    if (!load_solver(ctx)) {
+        return SUDOKU_ERROR_ERRONEOUS;
+    }
+    s->nodeLimit = maxNodes;
+    bit_search_begin(s);
+    for (freeDigits = bit_search_canonical(s); freeDigits > 1; freeDigits--) {
+        orbit = bit_count_add(0, orbit, freeDigits);
+    }
+    while ((status = bit_search_next(s)) == SEARCH_FOUND) {
+        *solutions = bit_count_add(*solutions, orbit, s->found);
+        if (*solutions == LONG_MAX) {
+            break;
+        }
+    }
+    bit_search_end(s);
+    s->nodeLimit = 0;
+    if (*solutions == LONG_MAX) {
+        return SUDOKU_ERROR_OVERFLOW;
+    }
+    return (status == SEARCH_STOPPED) ? SUDOKU_ERROR_BUDGET : SUDOKU_OK;
+}
+
+/* Generates the puzzle in the search context and keeps it once generation succeeded */
+int sudoku_generate(sudokuContext* ctx, int clues, int symmetric) {
+    bitSolver* s = &ctx->solver;
+    int idx;
+    if (clues < 0 || clues > ctx->size) {
+        return SUDOKU_ERROR_ARGUMENT;
+    }
+    s->stop = NULL;
+    if (generate_unique(s, ctx->blockRows, ctx->blockCols, clues, symmetric != 0, NULL) < 0) {
+        return SUDOKU_ERROR_GENERATE;
+    }
+    clear_context(ctx, ctx->blockRows, ctx->blockCols);
+    for (idx = 0; idx < ctx->size; idx++) {
+        ctx->values[idx] = s->grid[idx];
+        ctx->fixed[idx] = (s->grid[idx] != UNASSIGNED);
+    }
+    return SUDOKU_OK;
+}
+
+/* Returns the message of the error code */
+const char* sudoku_error_string(int code) {
+    switch (code) {
+        case SUDOKU_OK:
+            return "success";
+        case SUDOKU_ERROR_MEMORY:
+            return "memory allocation failed";
+        case SUDOKU_ERROR_ARGUMENT:
+            return "argument out of range";
+        case SUDOKU_ERROR_FILE:
+            return "file cannot be opened, read or written";
+        case SUDOKU_ERROR_FORMAT:
+            return "not a valid board";
+        case SUDOKU_ERROR_FIXED:
+            return "cell is fixed";
+        case SUDOKU_ERROR_ERRONEOUS:
+            return "board contains erroneous values";
+        case SUDOKU_ERROR_UNSOLVABLE:
+            return "board has no solution";
+        case SUDOKU_ERROR_BUDGET:
+            return "node budget exhausted";
+        case SUDOKU_ERROR_HISTORY:
+            return "no moves to undo or redo";
+        case SUDOKU_ERROR_GENERATE:
+            return "puzzle generation failed";
+        case SUDOKU_ERROR_OVERFLOW:
+            return "too many solutions to count";
+        default:
+            return "unknown error";
+    }
+}
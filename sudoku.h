@@ -0,0 +1,181 @@
+/** @file sudoku.h
+ *  @brief sudoku header file.
+ *
+ *  This header contains the public API of libsudoku, the library which holds every module of the game but main.
+ *  A sudokuContext holds one board with its fixed cells and move history, and every function works on its context
+ *  only, so contexts can be used from several threads at once (each context by one thread at a time).
+ *  Functions return SUDOKU_OK or a negative error code and never print or exit, even when memory runs out.
+ *  The shared library exports these functions only, the modules it is made of keep their symbols hidden.
+ *  Cells are addressed by column and row from 1 to N = blockRows * blockCols, like the set command, and a value of 0
+ *  is an empty cell.
+ *
+ *  @author Itay Keren (itaykeren)
+ *  @author Rotem Bar (rotembar)
+ *
+ */
+
+#ifndef SUDOKU_SUDOKU_H
+#define SUDOKU_SUDOKU_H
+
+/* -- Includes -- */
+#include <stddef.h>
+
+
+/* -- Defines -- */
+#if defined(__GNUC__) /* the library is built with hidden symbols, the API is exported */
+#define SUDOKU_API __attribute__((visibility("default")))
+#else
+#define SUDOKU_API
+#endif
+
+#define SUDOKU_MAX_SIZE 32 /* largest N = blockRows * blockCols */
+
+#define SUDOKU_OK 0
+#define SUDOKU_ERROR_MEMORY (-1) /* memory allocation failed, the context is unchanged */
+#define SUDOKU_ERROR_ARGUMENT (-2) /* dimensions, column, row, value or buffer size out of range */
+#define SUDOKU_ERROR_FILE (-3) /* the file cannot be opened, read or written */
+#define SUDOKU_ERROR_FORMAT (-4) /* the file or string is not a board */
+#define SUDOKU_ERROR_FIXED (-5) /* the cell is fixed */
+#define SUDOKU_ERROR_ERRONEOUS (-6) /* the board contains erroneous values */
+#define SUDOKU_ERROR_UNSOLVABLE (-7) /* the board has no solution */
+#define SUDOKU_ERROR_BUDGET (-8) /* the node budget ran out before the end of the search */
+#define SUDOKU_ERROR_HISTORY (-9) /* no moves to undo or redo */
+#define SUDOKU_ERROR_GENERATE (-10) /* no puzzle could be generated */
+#define SUDOKU_ERROR_OVERFLOW (-11) /* the number of solutions doesn't fit a long */
+
+
+/* -- Structs -- */
+
+typedef struct sudokuContext sudokuContext; /* opaque, defined in sudoku.c */
+
+
+/** @brief Creates a context holding an empty board of given dimensions.
+ *  @param ctx to be updated with the new context.
+ *  @param blockRows rows of a block.
+ *  @param blockCols columns of a block, blockRows * blockCols must not exceed SUDOKU_MAX_SIZE.
+ *  @param seed seed of the random generator of the context, the same seed generates the same puzzles.
+ *  @return SUDOKU_OK, SUDOKU_ERROR_ARGUMENT or SUDOKU_ERROR_MEMORY.
+ */
+SUDOKU_API int sudoku_create(sudokuContext** ctx, int blockRows, int blockCols, unsigned long seed);
+
+
+/** @brief Frees a context.
+ *  @param ctx context, may be NULL.
+ *  @return void.
+ */
+SUDOKU_API void sudoku_destroy(sudokuContext* ctx);
+
+
+/** @brief Returns the block dimensions of the board of a context.
+ *  @param ctx context.
+ *  @param blockRows to be updated with the rows of a block.
+ *  @param blockCols to be updated with the columns of a block.
+ *  @return void.
+ */
+SUDOKU_API void sudoku_dimensions(const sudokuContext* ctx, int* blockRows, int* blockCols);
+
+
+/** @brief Loads a board from a file in the format of the save command: a line with the block rows and columns,
+ *  then N lines of N values, a value followed by '.' is fixed. the history is cleared.
+ *  @param ctx context, unchanged on failure.
+ *  @param path file path.
+ *  @return SUDOKU_OK, SUDOKU_ERROR_FILE, SUDOKU_ERROR_FORMAT or SUDOKU_ERROR_MEMORY.
+ */
+SUDOKU_API int sudoku_load(sudokuContext* ctx, const char* path);
+
+
+/** @brief Loads a board from a line of N * N symbols as read by --batch-solve ('0' or '.' for an empty cell),
+ *  the dimensions are inferred from the length. the given values are fixed and the history is cleared.
+ *  @param ctx context, unchanged on failure.
+ *  @param line board line.
+ *  @return SUDOKU_OK or SUDOKU_ERROR_FORMAT (also when the given values conflict).
+ */
+SUDOKU_API int sudoku_load_string(sudokuContext* ctx, const char* line);
+
+
+/** @brief Saves the board to a file in the format read by sudoku_load and the edit and solve commands.
+ *  @param ctx context.
+ *  @param path file path.
+ *  @return SUDOKU_OK or SUDOKU_ERROR_FILE.
+ */
+SUDOKU_API int sudoku_save(const sudokuContext* ctx, const char* path);
+
+
+/** @brief Writes the board as a line of N * N symbols ('0' for an empty cell), ended by '\0'.
+ *  @param ctx context.
+ *  @param out buffer.
+ *  @param size buffer size, at least N * N + 1.
+ *  @return SUDOKU_OK or SUDOKU_ERROR_ARGUMENT.
+ */
+SUDOKU_API int sudoku_format(const sudokuContext* ctx, char* out, size_t size);
+
+
+/** @brief Reads the value of a cell.
+ *  @param ctx context.
+ *  @param column column of the cell, 1-N.
+ *  @param row row of the cell, 1-N.
+ *  @param value to be updated with the value, 0 if the cell is empty.
+ *  @return SUDOKU_OK or SUDOKU_ERROR_ARGUMENT.
+ */
+SUDOKU_API int sudoku_get(const sudokuContext* ctx, int column, int row, int* value);
+
+
+/** @brief Sets the value of a cell as a move of the history, like the set command erroneous values are allowed.
+ *  @param ctx context.
+ *  @param column column of the cell, 1-N.
+ *  @param row row of the cell, 1-N.
+ *  @param value value, 0-N (0 clears the cell).
+ *  @return SUDOKU_OK, SUDOKU_ERROR_ARGUMENT, SUDOKU_ERROR_FIXED or SUDOKU_ERROR_MEMORY.
+ */
+SUDOKU_API int sudoku_set(sudokuContext* ctx, int column, int row, int value);
+
+
+/** @brief Undoes the last move (a set, or every cell filled by a solve).
+ *  @param ctx context.
+ *  @return SUDOKU_OK or SUDOKU_ERROR_HISTORY.
+ */
+SUDOKU_API int sudoku_undo(sudokuContext* ctx);
+
+
+/** @brief Redoes the last undone move.
+ *  @param ctx context.
+ *  @return SUDOKU_OK or SUDOKU_ERROR_HISTORY.
+ */
+SUDOKU_API int sudoku_redo(sudokuContext* ctx);
+
+
+/** @brief Fills the empty cells of the board with a solution, as one move of the history.
+ *  @param ctx context.
+ *  @return SUDOKU_OK, SUDOKU_ERROR_ERRONEOUS, SUDOKU_ERROR_UNSOLVABLE or SUDOKU_ERROR_MEMORY.
+ */
+SUDOKU_API int sudoku_solve(sudokuContext* ctx);
+
+
+/** @brief Counts the solutions of the board, which remains unchanged.
+ *  @param ctx context.
+ *  @param maxNodes search nodes budget, 0 for no budget.
+ *  @param solutions to be updated with the number of solutions, the amount found before the budget ran out,
+ *  or LONG_MAX when there are more.
+ *  @return SUDOKU_OK, SUDOKU_ERROR_ERRONEOUS, SUDOKU_ERROR_BUDGET or SUDOKU_ERROR_OVERFLOW.
+ */
+SUDOKU_API int sudoku_count(sudokuContext* ctx, long maxNodes, long* solutions);
+
+
+/** @brief Replaces the board with a random puzzle of the same dimensions with a unique solution, the clues are fixed
+ *  and the history is cleared.
+ *  @param ctx context, unchanged on failure.
+ *  @param clues clues to stop removing at, 0 for a minimal puzzle.
+ *  @param symmetric non zero to keep the clues rotationally symmetric.
+ *  @return SUDOKU_OK, SUDOKU_ERROR_ARGUMENT or SUDOKU_ERROR_GENERATE.
+ */
+SUDOKU_API int sudoku_generate(sudokuContext* ctx, int clues, int symmetric);
+
+
+/** @brief Returns a message describing an error code.
+ *  @param code SUDOKU_OK or an error code.
+ *  @return constant message.
+ */
+SUDOKU_API const char* sudoku_error_string(int code);
+
+
+#endif /*SUDOKU_SUDOKU_H*/